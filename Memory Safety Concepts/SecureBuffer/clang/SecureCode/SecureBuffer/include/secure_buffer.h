@@ -3,6 +3,10 @@
 
 #include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Struct definition
 typedef struct {
     char *data;
@@ -15,4 +19,8 @@ void SecureBuffer_free(SecureBuffer *buf);
 int SecureBuffer_write(SecureBuffer *buf, const char *src, size_t len);
 void SecureBuffer_print(const SecureBuffer *buf);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // SECURE_BUFFER_H
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "include/AsyncIO.hpp"
+#include <cstdlib>
+#include <unistd.h>
+#include <vector>
+
+// Loading `range(0)` wrapped keys of 256 bytes each from one file (an
+// unlinked temporary file that stays in the page cache, so the numbers are
+// submission cost rather than device latency):
+//   BM_BlockingLoadKeys - one pread per key
+//   BM_AsyncLoadKeys    - the whole batch through AsyncIO; range(1) picks
+//                         io_uring (0), io_uring with fixed buffers (1) or
+//                         the thread-pool fallback (2)
+namespace
+{
+    constexpr size_t KeyBytes = 256;
+
+    int key_file(size_t keys)
+    {
+        char path[] = "/tmp/asyncio-bench-XXXXXX";
+        const int fd = mkstemp(path);
+        if (fd >= 0)
+            unlink(path);
+        std::vector<char> data(keys * KeyBytes, 0x5A);
+        if (fd < 0 || write(fd, data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+            return -1;
+        return fd;
+    }
+
+    std::vector<SecureBuffer> make_keys(size_t keys)
+    {
+        std::vector<SecureBuffer> bufs;
+        bufs.reserve(keys);
+        for (size_t i = 0; i < keys; ++i)
+            bufs.emplace_back(KeyBytes);
+        return bufs;
+    }
+}
+
+static void BM_BlockingLoadKeys(benchmark::State &state)
+{
+    const size_t keys = static_cast<size_t>(state.range(0));
+    const int fd = key_file(keys);
+    auto bufs = make_keys(keys);
+    for (auto _ : state){
+        for (size_t i = 0; i < keys; ++i){
+            if (pread(fd, bufs[i].data_ptr(), KeyBytes, static_cast<off_t>(i * KeyBytes)) != static_cast<ssize_t>(KeyBytes))
+                state.SkipWithError("short read");
+        }
+        benchmark::ClobberMemory();
+    }
+    close(fd);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_AsyncLoadKeys(benchmark::State &state)
+{
+    const size_t keys = static_cast<size_t>(state.range(0));
+    const int mode = static_cast<int>(state.range(1));
+    const auto preferred = mode == 2 ? AsyncIO::Backend::Threads : AsyncIO::Backend::IoUring;
+    if (preferred == AsyncIO::Backend::IoUring && !AsyncIO::io_uring_supported()){
+        state.SkipWithError("io_uring unavailable");
+        return;
+    }
+    const int fd = key_file(keys);
+    auto bufs = make_keys(keys);
+    AsyncIO io(AsyncIO::DefaultQueueDepth, preferred);
+    if (mode == 1 && !io.register_buffers(bufs)){
+        state.SkipWithError("buffer registration refused");
+        return;
+    }
+    size_t failed = 0;
+    for (auto _ : state){
+        for (size_t i = 0; i < keys; ++i){
+            io.read(fd, bufs[i], i * KeyBytes, [&failed](ssize_t res) {
+                failed += res != static_cast<ssize_t>(KeyBytes);
+            });
+        }
+        io.drain();
+        benchmark::ClobberMemory();
+    }
+    if (failed)
+        state.SkipWithError("short read");
+    close(fd);
+    const char *labels[] = {"io_uring", "io_uring fixed", "threads"};
+    state.SetLabel(labels[mode]);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Wall-clock time: io_uring and thread-pool work partly runs off this thread.
+BENCHMARK(BM_BlockingLoadKeys)->RangeMultiplier(16)->Range(16, 4096)->UseRealTime();
+BENCHMARK(BM_AsyncLoadKeys)->ArgsProduct({{16, 256, 4096}, {0, 1, 2}})->UseRealTime();
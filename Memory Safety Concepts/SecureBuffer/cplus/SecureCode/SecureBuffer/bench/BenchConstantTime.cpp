@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "include/ConstantTime.hpp"
+#include <cstring>
+#include <vector>
+
+using consttime::Kernel;
+
+// Comparison throughput of equal inputs (memcmp's worst case, since it has
+// to read everything) per constant-time kernel, against memcmp itself.
+static void BM_ConstantTimeEqual(benchmark::State &state, Kernel k)
+{
+    if (!consttime::is_supported(k)){
+        state.SkipWithError("kernel not supported on this CPU");
+        return;
+    }
+    const size_t len = static_cast<size_t>(state.range(0));
+    std::vector<char> a(len, 1), b(len, 1);
+    for (auto _ : state){
+        benchmark::DoNotOptimize(consttime::equal_with(k, a.data(), b.data(), len));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_Memcmp(benchmark::State &state)
+{
+    const size_t len = static_cast<size_t>(state.range(0));
+    std::vector<char> a(len, 1), b(len, 1);
+    for (auto _ : state){
+        benchmark::DoNotOptimize(std::memcmp(a.data(), b.data(), len));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Sizes: a 32-byte MAC up to 1 MiB.
+#define COMPARE_SIZES RangeMultiplier(8)->Range(32, 1 << 20)
+
+BENCHMARK_CAPTURE(BM_ConstantTimeEqual, scalar, Kernel::Scalar)->COMPARE_SIZES;
+BENCHMARK_CAPTURE(BM_ConstantTimeEqual, sse2, Kernel::SSE2)->COMPARE_SIZES;
+BENCHMARK_CAPTURE(BM_ConstantTimeEqual, avx2, Kernel::AVX2)->COMPARE_SIZES;
+BENCHMARK(BM_Memcmp)->COMPARE_SIZES;
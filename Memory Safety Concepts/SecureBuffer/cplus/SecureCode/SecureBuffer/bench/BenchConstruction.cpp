@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureBuffer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+// Construction latency only: the clock is stopped before destruction so the
+// wipe does not hide the difference between allocation paths.
+template <typename Make>
+static void construct_loop(benchmark::State &state, Make make)
+{
+    for (auto _ : state){
+        auto start = std::chrono::high_resolution_clock::now();
+        auto buf = make(static_cast<size_t>(state.range(0)));
+        auto stop = std::chrono::high_resolution_clock::now();
+        benchmark::DoNotOptimize(buf);
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    }
+}
+
+// The original constructor: value-initialize, then fill the same bytes again.
+static void BM_ConstructDoubleZero(benchmark::State &state)
+{
+    construct_loop(state, [](size_t n) {
+        auto p = std::make_unique<char[]>(n);
+        std::fill(p.get(), p.get() + n, 0);
+        return p;
+    });
+}
+
+static void BM_ConstructHeap(benchmark::State &state)
+{
+    construct_loop(state, [](size_t n) {
+        return std::make_unique<SecureBuffer>(n, SecureBuffer::Storage::Heap);
+    });
+}
+
+static void BM_ConstructMapped(benchmark::State &state)
+{
+    construct_loop(state, [](size_t n) {
+        return std::make_unique<SecureBuffer>(n, SecureBuffer::Storage::Mapped);
+    });
+}
+
+// Arena-backed storage: after the first region is mapped, construction is a
+// free-list pop, so these should track the heap path.
+static void BM_ConstructLocked(benchmark::State &state)
+{
+    construct_loop(state, [](size_t n) {
+        return std::make_unique<SecureBuffer>(n, SecureBuffer::Storage::Locked);
+    });
+}
+
+static void BM_ConstructSecret(benchmark::State &state)
+{
+    construct_loop(state, [](size_t n) {
+        return std::make_unique<SecureBuffer>(n, SecureBuffer::Storage::Secret);
+    });
+}
+
+// Default constructor: heap below `MappedThreshold`, zero pages above.
+static void BM_ConstructDefault(benchmark::State &state)
+{
+    construct_loop(state, [](size_t n) { return std::make_unique<SecureBuffer>(n); });
+}
+
+// 64 B .. 256 MiB. Large sizes run a fixed number of iterations: the timed
+// region is tiny for mapped buffers, but the untimed wipe on destruction is
+// not, and would otherwise make the run take minutes.
+#define CONSTRUCT_SMALL RangeMultiplier(8)->Range(64, 1 << 20)->UseManualTime()
+#define CONSTRUCT_LARGE RangeMultiplier(8)->Range(8 << 20, 256 << 20)->UseManualTime()->Iterations(10)
+
+BENCHMARK(BM_ConstructDoubleZero)->CONSTRUCT_SMALL;
+BENCHMARK(BM_ConstructDoubleZero)->CONSTRUCT_LARGE;
+BENCHMARK(BM_ConstructHeap)->CONSTRUCT_SMALL;
+BENCHMARK(BM_ConstructHeap)->CONSTRUCT_LARGE;
+BENCHMARK(BM_ConstructMapped)->CONSTRUCT_SMALL;
+BENCHMARK(BM_ConstructMapped)->CONSTRUCT_LARGE;
+BENCHMARK(BM_ConstructDefault)->CONSTRUCT_SMALL;
+BENCHMARK(BM_ConstructDefault)->CONSTRUCT_LARGE;
+BENCHMARK(BM_ConstructLocked)->RangeMultiplier(8)->Range(64, 64 << 10)->UseManualTime();
+BENCHMARK(BM_ConstructSecret)->RangeMultiplier(8)->Range(64, 64 << 10)->UseManualTime();
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include "include/DeferredWiper.hpp"
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+// Latency seen by the thread that destroys a written buffer, with the wipe
+// done inline versus handed to the background wiper. The deferred variant
+// should stay flat across sizes; the wiper is flushed outside the timed region.
+static void destroy_latency(benchmark::State &state, bool deferred)
+{
+    DeferredWiper &wiper = DeferredWiper::instance();
+    if (deferred)
+        wiper.enable(DeferredWiper::DefaultThreshold);
+    for (auto _ : state){
+        auto buf = std::make_unique<SecureBuffer>(static_cast<size_t>(state.range(0)));
+        std::memset(buf->data_ptr(), 0x5A, buf->size_bytes());
+        auto start = std::chrono::high_resolution_clock::now();
+        buf.reset();
+        auto stop = std::chrono::high_resolution_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+        wiper.flush();
+    }
+    if (deferred)
+        wiper.disable();
+}
+
+static void BM_DestroyInlineWipe(benchmark::State &state)
+{
+    destroy_latency(state, false);
+}
+
+static void BM_DestroyDeferredWipe(benchmark::State &state)
+{
+    destroy_latency(state, true);
+}
+
+BENCHMARK(BM_DestroyInlineWipe)->RangeMultiplier(8)->Range(1 << 20, 256 << 20)->Iterations(10)->UseManualTime();
+BENCHMARK(BM_DestroyDeferredWipe)->RangeMultiplier(8)->Range(1 << 20, 256 << 20)->Iterations(10)->UseManualTime();
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureBuffer.hpp"
+#include "include/SecureWipe.hpp"
+#include <chrono>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// fork() of a process holding 64 MiB of secrets, until the child has
+// disposed of them. With `Storage::Mapped` the child must wipe its
+// copy-on-write view, which copies every page before zeroing it; with
+// `Storage::WipeOnFork` the child starts on zero pages and does nothing.
+static void BM_ForkWithSecrets(benchmark::State &state)
+{
+    constexpr size_t Bytes = size_t(64) << 20;
+    const auto storage = static_cast<SecureBuffer::Storage>(state.range(0));
+    SecureBuffer secrets(Bytes, storage);
+    std::memset(secrets.data_ptr(), 0x5A, Bytes);
+    const bool child_wipes = secrets.storage() != SecureBuffer::Storage::WipeOnFork;
+    for (auto _ : state){
+        auto start = std::chrono::high_resolution_clock::now();
+        const pid_t pid = fork();
+        if (pid == 0){
+            if (child_wipes)
+                securewipe::wipe(secrets.data_ptr(), Bytes);
+            _exit(0);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        auto stop = std::chrono::high_resolution_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    }
+    state.SetLabel(child_wipes ? "child wipes" : "wipe-on-fork");
+}
+
+BENCHMARK(BM_ForkWithSecrets)
+    ->Arg(static_cast<int>(SecureBuffer::Storage::Mapped))
+    ->Arg(static_cast<int>(SecureBuffer::Storage::WipeOnFork))
+    ->UseManualTime();
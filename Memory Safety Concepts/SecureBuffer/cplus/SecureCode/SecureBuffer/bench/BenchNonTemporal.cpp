@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include "include/NonTemporal.hpp"
+#include "include/SecureWipe.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Cache pollution of a bulk wipe. Each iteration wipes a 512 MiB buffer
+// while a second thread runs a dependent random walk over a 4 MiB "hot"
+// working set that it made cache-resident just before the wipe started; the
+// walker's step rate during the wipe is what is reported. With regular
+// stores the wipe evicts the working set from the shared last-level cache
+// and every step becomes a DRAM miss; with streaming stores it stays cached.
+// Needs at least two cores: on one core the threads only time-slice.
+static void BM_WorkingSetAfterWipe(benchmark::State &state)
+{
+    const bool streaming = state.range(0) != 0;
+    std::vector<char> victim(size_t(512) << 20, 1);
+    // One random cycle through every cache line of the working set.
+    constexpr size_t Stride = 64 / sizeof(uint64_t);
+    std::vector<uint64_t> hot((size_t(4) << 20) / sizeof(uint64_t));
+    const size_t lines = hot.size() / Stride;
+    for (size_t i = 0; i < lines; ++i){
+        hot[i * Stride] = i * Stride;
+    }
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (size_t i = lines - 1; i > 0; --i){
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        std::swap(hot[i * Stride], hot[(x % i) * Stride]);
+    }
+    uint64_t pos = 0;
+    int64_t steps = 0;
+    for (auto _ : state){
+        std::atomic<bool> warm{false}, done{false};
+        double walked = 0;
+        std::thread walker([&]{
+            for (size_t i = 0; i < lines; ++i){
+                pos = hot[pos];
+            }
+            warm.store(true, std::memory_order_release);
+            const auto start = std::chrono::steady_clock::now();
+            while (!done.load(std::memory_order_acquire)){
+                for (size_t i = 0; i < lines; ++i){
+                    pos = hot[pos];
+                }
+                steps += static_cast<int64_t>(lines);
+            }
+            walked = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        });
+        while (!warm.load(std::memory_order_acquire)){
+            std::this_thread::yield();
+        }
+        if (streaming)
+            nontemporal::zero(victim.data(), victim.size());
+        else
+            securewipe::wipe_with(securewipe::active_kernel(), victim.data(), victim.size());
+        done.store(true, std::memory_order_release);
+        walker.join();
+        state.SetIterationTime(walked);
+    }
+    benchmark::DoNotOptimize(pos);
+    state.SetItemsProcessed(steps);
+}
+
+// Raw throughput of both store kinds on a buffer far larger than the caches.
+static void BM_BulkWipe(benchmark::State &state)
+{
+    const bool streaming = state.range(0) != 0;
+    std::vector<char> mem(size_t(256) << 20, 1);
+    for (auto _ : state){
+        if (streaming)
+            nontemporal::zero(mem.data(), mem.size());
+        else
+            securewipe::wipe_with(securewipe::active_kernel(), mem.data(), mem.size());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mem.size()));
+}
+
+BENCHMARK(BM_WorkingSetAfterWipe)->ArgName("streaming")->Arg(0)->Arg(1)->Iterations(20)->UseManualTime();
+BENCHMARK(BM_BulkWipe)->ArgName("streaming")->Arg(0)->Arg(1)->Iterations(10);
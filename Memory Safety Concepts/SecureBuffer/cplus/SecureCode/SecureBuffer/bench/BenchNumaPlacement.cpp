@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include "include/NumaPlacement.hpp"
+#include "include/SecureBuffer.hpp"
+#include <cstdint>
+#include <cstring>
+
+// Dependent random reads (pointer chasing, so latency is not hidden by
+// memory-level parallelism) over a 64 MiB Storage::Numa buffer on the node
+// the benchmark thread runs on (local) and on the next node (remote).
+//
+// On a single-node machine the remote case is skipped; run under a
+// simulated topology (e.g. `qemu -numa node,... -numa dist,...`) or on a
+// multi-socket host to see the cross-node penalty.
+static void BM_NumaChase(benchmark::State &state)
+{
+    const bool remote = state.range(0) != 0;
+    if (remote && numa::node_count() < 2){
+        state.SkipWithError("single NUMA node");
+        return;
+    }
+    const int here = numa::current_node();
+    const int node = remote ? (here + 1) % numa::node_count() : here;
+
+    constexpr size_t Slots = (size_t(64) << 20) / sizeof(uint32_t);
+    SecureBuffer buf(Slots * sizeof(uint32_t), SecureBuffer::Storage::Numa, node);
+    uint32_t *next = reinterpret_cast<uint32_t *>(buf.data_ptr());
+
+    // Sattolo's shuffle: a single cycle through every slot, on cache-line
+    // granularity so every step is a miss.
+    constexpr size_t Stride = 64 / sizeof(uint32_t);
+    constexpr size_t Lines = Slots / Stride;
+    for (size_t i = 0; i < Lines; ++i){
+        next[i * Stride] = static_cast<uint32_t>(i * Stride);
+    }
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (size_t i = Lines - 1; i > 0; --i){
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        const size_t j = x % i;
+        std::swap(next[i * Stride], next[j * Stride]);
+    }
+
+    uint32_t pos = 0;
+    for (auto _ : state){
+        for (int i = 0; i < 1024; ++i){
+            pos = next[pos];
+        }
+    }
+    benchmark::DoNotOptimize(pos);
+    state.SetLabel("node " + std::to_string(node) + " of " + std::to_string(numa::node_count()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 1024);
+}
+
+BENCHMARK(BM_NumaChase)->ArgName("remote")->Arg(0)->Arg(1);
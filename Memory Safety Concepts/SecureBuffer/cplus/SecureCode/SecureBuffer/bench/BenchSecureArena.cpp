@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureArena.hpp"
+#include "include/SecureBuffer.hpp"
+#include <memory>
+#include <vector>
+
+// One simulated request: a few dozen small secrets (tokens, derived keys,
+// nonces), created and then all released. Individual SecureBuffers pay an
+// allocation, a wipe and a free each; the arena pays pointer bumps plus one
+// wipe of the used region on reset.
+static const size_t request_sizes[] = {16, 32, 32, 48, 64, 128, 256, 512};
+constexpr size_t SecretsPerRequest = 48;
+
+static void BM_RequestSecureBuffers(benchmark::State &state)
+{
+    const auto storage = static_cast<SecureBuffer::Storage>(state.range(0));
+    std::vector<std::unique_ptr<SecureBuffer>> live(SecretsPerRequest);
+    for (auto _ : state){
+        for (size_t i = 0; i < SecretsPerRequest; ++i){
+            live[i] = std::make_unique<SecureBuffer>(request_sizes[i % 8], storage);
+            benchmark::DoNotOptimize(live[i]->data_ptr());
+        }
+        for (auto &slot : live){
+            slot.reset();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * SecretsPerRequest));
+}
+
+static void BM_RequestSecureArena(benchmark::State &state)
+{
+    SecureArena arena;
+    for (auto _ : state){
+        for (size_t i = 0; i < SecretsPerRequest; ++i){
+            SecureSpan s = arena.allocate(request_sizes[i % 8]);
+            benchmark::DoNotOptimize(s.data());
+        }
+        arena.reset();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * SecretsPerRequest));
+}
+
+BENCHMARK(BM_RequestSecureBuffers)
+    ->Arg(static_cast<int>(SecureBuffer::Storage::Heap))
+    ->Arg(static_cast<int>(SecureBuffer::Storage::Pool));
+BENCHMARK(BM_RequestSecureArena);
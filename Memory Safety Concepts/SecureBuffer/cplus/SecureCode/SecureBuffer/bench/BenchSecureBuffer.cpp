@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureBuffer.hpp"
+#include "include/SecureWipe.hpp"
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// Lifecycle benchmarks for the C++ SecureBuffer: construction, destruction
+// (wipe + release), move construction and move assignment. Each runs from
+// 16 B to 1 GiB single-threaded, and up to 4 MiB with 2..8 threads to expose
+// allocator contention.
+
+static size_t bytes_arg(const benchmark::State &state)
+{
+    return static_cast<size_t>(state.range(0));
+}
+
+// Construction only; the buffer is destroyed outside the timed region.
+static void BM_SecureBufferConstruct(benchmark::State &state)
+{
+    for (auto _ : state){
+        auto start = std::chrono::high_resolution_clock::now();
+        auto buf = std::make_unique<SecureBuffer>(bytes_arg(state));
+        auto stop = std::chrono::high_resolution_clock::now();
+        benchmark::DoNotOptimize(buf->data_ptr());
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Destruction only: wipe plus release of a fully written buffer.
+static void BM_SecureBufferDestroy(benchmark::State &state)
+{
+    for (auto _ : state){
+        auto buf = std::make_unique<SecureBuffer>(bytes_arg(state));
+        std::memset(buf->data_ptr(), 0x5A, buf->size_bytes());
+        auto start = std::chrono::high_resolution_clock::now();
+        buf.reset();
+        auto stop = std::chrono::high_resolution_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Move construction back and forth between two slots; each step also
+// destroys the moved-from object the slot held before.
+static void BM_SecureBufferMoveConstruct(benchmark::State &state)
+{
+    std::optional<SecureBuffer> a(std::in_place, bytes_arg(state));
+    std::optional<SecureBuffer> b;
+    for (auto _ : state){
+        b.emplace(std::move(*a));
+        a.emplace(std::move(*b));
+        benchmark::DoNotOptimize(a->data_ptr());
+    }
+}
+
+// Move assignment between two live buffers of the same size; each step wipes
+// the destination's previous contents.
+static void BM_SecureBufferMoveAssign(benchmark::State &state)
+{
+    SecureBuffer a(bytes_arg(state));
+    SecureBuffer b(bytes_arg(state));
+    for (auto _ : state){
+        b = std::move(a);
+        a = std::move(b);
+        benchmark::DoNotOptimize(a.data_ptr());
+    }
+}
+
+// 16 B .. 1 GiB single-threaded; large sizes use a fixed iteration count.
+#define LIFECYCLE_SMALL RangeMultiplier(16)->Range(16, 4 << 20)
+#define LIFECYCLE_LARGE RangeMultiplier(16)->Range(64 << 20, 1 << 30)->Iterations(3)
+// Up to 4 MiB with 2..8 threads.
+#define LIFECYCLE_THREADS RangeMultiplier(16)->Range(16, 4 << 20)->ThreadRange(2, 8)
+
+BENCHMARK(BM_SecureBufferConstruct)->LIFECYCLE_SMALL->UseManualTime();
+BENCHMARK(BM_SecureBufferConstruct)->LIFECYCLE_LARGE->UseManualTime();
+BENCHMARK(BM_SecureBufferConstruct)->LIFECYCLE_THREADS->UseManualTime();
+BENCHMARK(BM_SecureBufferDestroy)->LIFECYCLE_SMALL->UseManualTime();
+BENCHMARK(BM_SecureBufferDestroy)->LIFECYCLE_LARGE->UseManualTime();
+BENCHMARK(BM_SecureBufferDestroy)->LIFECYCLE_THREADS->UseManualTime();
+BENCHMARK(BM_SecureBufferMoveConstruct)->LIFECYCLE_SMALL;
+BENCHMARK(BM_SecureBufferMoveConstruct)->LIFECYCLE_LARGE;
+BENCHMARK(BM_SecureBufferMoveConstruct)->LIFECYCLE_THREADS;
+BENCHMARK(BM_SecureBufferMoveAssign)->LIFECYCLE_SMALL;
+BENCHMARK(BM_SecureBufferMoveAssign)->LIFECYCLE_LARGE;
+BENCHMARK(BM_SecureBufferMoveAssign)->LIFECYCLE_THREADS;
+
+// Random 8-byte reads over a 256 MiB buffer on base pages (Mapped) and huge
+// pages (Huge); the gap is the TLB miss cost huge pages remove. The label
+// reports which backing `Storage::Huge` actually got.
+static void BM_SecureBufferRandomRead(benchmark::State &state)
+{
+    constexpr size_t Bytes = size_t(256) << 20;
+    const auto storage = static_cast<SecureBuffer::Storage>(state.range(0));
+    SecureBuffer buf(Bytes, storage);
+    std::memset(buf.data_ptr(), 1, Bytes);
+    uint64_t x = 88172645463325252ull, sum = 0;
+    for (auto _ : state){
+        for (int i = 0; i < 1024; ++i){
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            sum += static_cast<unsigned char>(buf.data_ptr()[(x % (Bytes / 8)) * 8]);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetLabel(pagealloc::backing_name(buf.page_backing()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 1024);
+}
+
+BENCHMARK(BM_SecureBufferRandomRead)
+    ->Arg(static_cast<int>(SecureBuffer::Storage::Mapped))
+    ->Arg(static_cast<int>(SecureBuffer::Storage::Huge));
+
+// Wiping a fully written mapped buffer by dropping its pages (arg 1, what
+// `SecureBuffer` does above `DiscardThreshold`) versus storing zeros over
+// every byte (arg 0). The buffer is re-dirtied outside the timed region.
+static void BM_DiscardWipe(benchmark::State &state)
+{
+    const size_t bytes = bytes_arg(state);
+    const bool discard = state.range(1) != 0;
+    SecureBuffer buf(bytes, SecureBuffer::Storage::Mapped);
+    for (auto _ : state){
+        buf.resize(bytes);
+        std::memset(buf.data_ptr(), 0x5A, bytes);
+        auto start = std::chrono::high_resolution_clock::now();
+        if (discard){
+            buf.resize(0);
+        } else {
+            securewipe::wipe(buf.data_ptr(), bytes);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        benchmark::DoNotOptimize(buf.data_ptr());
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    }
+    state.SetLabel(discard ? "madvise" : "stores");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(BM_DiscardWipe)
+    ->ArgsProduct({{64 << 20, 1 << 30}, {0, 1}})
+    ->Iterations(3)
+    ->UseManualTime();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureIO.hpp"
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+// Loading `range(0)` 64-byte keys from a file (an in-memory memfd, so the
+// numbers are syscall and copy cost, not disk):
+//   Staged     - read() each key into a stack array, copy it in, wipe the array
+//   PerBuffer  - SecureBuffer::read_from, one readv per key, no staging copy
+//   Vectored   - secureio::read_from over all keys, one readv per IOV_MAX keys
+namespace
+{
+    constexpr size_t KeyBytes = 64;
+
+    int key_file(size_t keys)
+    {
+        const int fd = memfd_create("secureio-bench", MFD_CLOEXEC);
+        std::vector<char> data(keys * KeyBytes, 0x5A);
+        if (fd < 0 || write(fd, data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+            return -1;
+        return fd;
+    }
+
+    std::vector<SecureBuffer> make_keys(size_t keys)
+    {
+        std::vector<SecureBuffer> bufs;
+        bufs.reserve(keys);
+        for (size_t i = 0; i < keys; ++i)
+            bufs.emplace_back(KeyBytes);
+        return bufs;
+    }
+}
+
+static void BM_LoadKeysStaged(benchmark::State &state)
+{
+    const size_t keys = static_cast<size_t>(state.range(0));
+    const int fd = key_file(keys);
+    auto bufs = make_keys(keys);
+    for (auto _ : state){
+        lseek(fd, 0, SEEK_SET);
+        for (SecureBuffer &b : bufs){
+            char staging[KeyBytes];
+            if (read(fd, staging, KeyBytes) != static_cast<ssize_t>(KeyBytes))
+                state.SkipWithError("short read");
+            std::memcpy(b.data_ptr(), staging, KeyBytes);
+            explicit_bzero(staging, KeyBytes);
+        }
+        benchmark::ClobberMemory();
+    }
+    close(fd);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_LoadKeysPerBuffer(benchmark::State &state)
+{
+    const size_t keys = static_cast<size_t>(state.range(0));
+    const int fd = key_file(keys);
+    auto bufs = make_keys(keys);
+    for (auto _ : state){
+        lseek(fd, 0, SEEK_SET);
+        for (SecureBuffer &b : bufs)
+            b.read_from(fd);
+        benchmark::ClobberMemory();
+    }
+    close(fd);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_LoadKeysVectored(benchmark::State &state)
+{
+    const size_t keys = static_cast<size_t>(state.range(0));
+    const int fd = key_file(keys);
+    auto bufs = make_keys(keys);
+    for (auto _ : state){
+        lseek(fd, 0, SEEK_SET);
+        secureio::read_from(fd, bufs);
+        benchmark::ClobberMemory();
+    }
+    close(fd);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(BM_LoadKeysStaged)->RangeMultiplier(16)->Range(1, 4096);
+BENCHMARK(BM_LoadKeysPerBuffer)->RangeMultiplier(16)->Range(1, 4096);
+BENCHMARK(BM_LoadKeysVectored)->RangeMultiplier(16)->Range(1, 4096);
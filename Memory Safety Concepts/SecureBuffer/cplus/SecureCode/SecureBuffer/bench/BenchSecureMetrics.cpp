@@ -0,0 +1,20 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureBuffer.hpp"
+#include "include/SecureMetrics.hpp"
+#include <utility>
+
+// Construct, move and destroy a small heap buffer with the lifecycle metrics
+// off (0), counters only (1) and counters plus wipe timing (2).
+static void BM_LifecycleMetrics(benchmark::State &state)
+{
+    if (state.range(0))
+        securemetrics::enable(state.range(0) == 2);
+    for (auto _ : state){
+        SecureBuffer a(256, SecureBuffer::Storage::Heap);
+        SecureBuffer b(std::move(a));
+        benchmark::DoNotOptimize(b.data_ptr());
+    }
+    securemetrics::disable();
+}
+
+BENCHMARK(BM_LifecycleMetrics)->ArgName("mode")->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureBuffer.hpp"
+#include <memory>
+#include <vector>
+
+// Multi-threaded allocation/release churn of small secrets (32..4096 bytes),
+// pooled (per-thread magazines) against the heap. With the magazine cache
+// the per-thread rate should stay flat as the thread count grows.
+static void churn(benchmark::State &state, SecureBuffer::Storage storage)
+{
+    constexpr size_t Batch = 64;
+    static const size_t sizes[] = {32, 48, 64, 128, 256, 512, 1024, 4096};
+    std::vector<std::unique_ptr<SecureBuffer>> live(Batch);
+    size_t k = 0;
+    for (auto _ : state){
+        for (auto &slot : live){
+            slot = std::make_unique<SecureBuffer>(sizes[k++ % 8], storage);
+        }
+        for (auto &slot : live){
+            slot.reset();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * Batch));
+}
+
+static void BM_PoolChurn(benchmark::State &state)
+{
+    churn(state, SecureBuffer::Storage::Pool);
+}
+
+static void BM_HeapChurn(benchmark::State &state)
+{
+    churn(state, SecureBuffer::Storage::Heap);
+}
+
+BENCHMARK(BM_PoolChurn)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_HeapChurn)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureBuffer.hpp"
+#include "include/SecureQueue.hpp"
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+// Hand-off throughput of 32-byte SecureBuffers between N producers and
+// N consumers (threads 2, 8, 32 -> 1/4/16 of each). Even-numbered threads
+// produce, odd-numbered threads consume, and every thread moves `PerIter`
+// elements per iteration, so pushes and pops balance out.
+namespace
+{
+    constexpr int PerIter = 256;
+    constexpr size_t Capacity = 1024;
+
+    // The baseline: a mutex-guarded std::deque with the same bound.
+    class LockedDeque
+    {
+    public:
+        bool try_push(SecureBuffer &&b)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (items.size() == Capacity)
+                return false;
+            items.push_back(std::move(b));
+            return true;
+        }
+        std::optional<SecureBuffer> try_pop()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (items.empty())
+                return std::nullopt;
+            std::optional<SecureBuffer> out(std::move(items.front()));
+            items.pop_front();
+            return out;
+        }
+
+    private:
+        std::mutex lock;
+        std::deque<SecureBuffer> items;
+    };
+
+    template <typename Queue>
+    void handoff(benchmark::State &state, Queue &q)
+    {
+        const bool producer = state.thread_index() % 2 == 0;
+        for (auto _ : state){
+            for (int i = 0; i < PerIter; ++i){
+                if (producer){
+                    SecureBuffer b(32);
+                    while (!q.try_push(std::move(b)))
+                        std::this_thread::yield();
+                } else {
+                    std::optional<SecureBuffer> b;
+                    while (!(b = q.try_pop()))
+                        std::this_thread::yield();
+                    benchmark::DoNotOptimize(b->data_ptr());
+                }
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * PerIter);
+    }
+}
+
+static void BM_SecureQueueHandoff(benchmark::State &state)
+{
+    static SecureQueue<SecureBuffer> q(Capacity);
+    handoff(state, q);
+}
+
+static void BM_LockedDequeHandoff(benchmark::State &state)
+{
+    static LockedDeque q;
+    handoff(state, q);
+}
+
+BENCHMARK(BM_SecureQueueHandoff)->Threads(2)->Threads(8)->Threads(32)->UseRealTime();
+BENCHMARK(BM_LockedDequeHandoff)->Threads(2)->Threads(8)->Threads(32)->UseRealTime();
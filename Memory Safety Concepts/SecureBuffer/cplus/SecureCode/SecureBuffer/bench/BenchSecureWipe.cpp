@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include "include/SecureWipe.hpp"
+#include <vector>
+
+using securewipe::Kernel;
+
+// Wipe throughput per kernel. Google Benchmark reports `bytes_per_second`,
+// so the output reads directly as GB/s per kernel and buffer size.
+static void BM_Wipe(benchmark::State &state, Kernel k)
+{
+    if (!securewipe::is_supported(k)){
+        state.SkipWithError("kernel not supported on this CPU");
+        return;
+    }
+    std::vector<char> mem(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state){
+        securewipe::wipe_with(k, mem.data(), mem.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Sizes: 4 KiB (L1) up to 64 MiB (DRAM).
+#define WIPE_SIZES RangeMultiplier(16)->Range(4 << 10, 64 << 20)
+
+BENCHMARK_CAPTURE(BM_Wipe, scalar, Kernel::Scalar)->WIPE_SIZES;
+BENCHMARK_CAPTURE(BM_Wipe, sse2, Kernel::SSE2)->WIPE_SIZES;
+BENCHMARK_CAPTURE(BM_Wipe, avx2, Kernel::AVX2)->WIPE_SIZES;
+BENCHMARK_CAPTURE(BM_Wipe, avx512, Kernel::AVX512)->WIPE_SIZES;
+
+// The dispatched entry point used by SecureBuffer.
+static void BM_WipeDispatched(benchmark::State &state)
+{
+    std::vector<char> mem(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state){
+        securewipe::wipe(mem.data(), mem.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    state.SetLabel(securewipe::kernel_name(securewipe::active_kernel()));
+}
+BENCHMARK(BM_WipeDispatched)->WIPE_SIZES;
@@ -0,0 +1,20 @@
+#include <benchmark/benchmark.h>
+#include "include/WipeThreadPool.hpp"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Parallel wipe of a 1 GiB range with 0 (caller only), 1, 3 and 7 pool
+// threads. Throughput should grow until memory bandwidth is saturated.
+static void BM_ParallelWipe(benchmark::State &state)
+{
+    WipeThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::vector<char> mem(size_t(1) << 30, 1);
+    for (auto _ : state){
+        pool.wipe(mem.data(), mem.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mem.size()));
+}
+
+BENCHMARK(BM_ParallelWipe)->ArgName("threads")->Arg(0)->Arg(1)->Arg(3)->Arg(7)->Iterations(5)->UseRealTime();
@@ -0,0 +1,129 @@
+#ifndef ASYNCIO_HPP
+#define ASYNCIO_HPP
+
+#include "include/SecureBuffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unordered_map>
+#include <vector>
+
+// Batched asynchronous reads and writes into SecureBuffers.
+//
+// `read`/`write` only queue an operation; `submit()` hands everything queued
+// to the kernel at once and `wait()` runs the completion callbacks on the
+// calling thread. On Linux the engine is an io_uring driven through raw
+// syscalls (no liburing): a whole batch costs one `io_uring_enter`, and
+// buffers passed to `register_buffers` are pinned once as fixed buffers so
+// the kernel skips the per-operation page lookup. Where io_uring is missing
+// or disabled (or compiled out with -DSECUREBUFFER_NO_IO_URING) a small
+// thread pool runs blocking pread/pwrite instead, with the same interface
+// and the callbacks still run by `wait()`.
+//
+// Buffers must stay alive and unmoved until their operation completes, and
+// registered buffers until `unregister_buffers()`. Each operation transfers
+// `size_bytes()` bytes at most; a short count is reported as is.
+// `Storage::Secret` memory cannot be pinned, and buffers whose wipes drop
+// pages with MADV_DONTNEED (`SecureBuffer::discards_pages`) must not be, so
+// neither is ever a fixed buffer; both still work through plain READV/WRITEV.
+class AsyncIO
+{
+public:
+    enum class Backend : unsigned char
+    {
+        IoUring, // submission/completion rings, one syscall per batch
+        Threads  // worker threads doing blocking pread/pwrite
+    };
+
+    // Receives the number of bytes transferred, or -errno. Callbacks may
+    // queue further operations but must not throw or call `wait`/`drain`.
+    using Callback = std::function<void(ssize_t result)>;
+
+    // Offset for pipes and sockets: use (and advance) the file position.
+    static constexpr uint64_t CurrentPosition = UINT64_MAX;
+
+    static constexpr unsigned DefaultQueueDepth = 256;
+    static constexpr unsigned DefaultThreads = 4;
+
+    // @param queue_depth Maximum operations in flight; queuing more first
+    //                    waits for (and runs the callbacks of) earlier ones.
+    // @param preferred   `Backend::Threads` skips io_uring altogether.
+    // @param threads     Worker count for the thread-pool backend.
+    explicit AsyncIO(unsigned queue_depth = DefaultQueueDepth, Backend preferred = Backend::IoUring,
+                     unsigned threads = DefaultThreads);
+
+    // Waits for every queued operation, then tears the engine down.
+    ~AsyncIO();
+
+    AsyncIO(const AsyncIO &) = delete;
+    AsyncIO &operator=(const AsyncIO &) = delete;
+
+    // Whether this kernel lets the process create an io_uring (probed once).
+    static bool io_uring_supported() noexcept;
+
+    Backend backend() const noexcept;
+    static const char *backend_name(Backend backend) noexcept;
+
+    // Registers `bufs` as io_uring fixed buffers, replacing any earlier set;
+    // waits for in-flight operations first. Later reads and writes on these
+    // buffers use READ_FIXED/WRITE_FIXED.
+    // @return False if nothing was registered (thread backend, or the kernel
+    //         refused, e.g. over RLIMIT_MEMLOCK); operations still work.
+    bool register_buffers(std::span<SecureBuffer> bufs);
+    void unregister_buffers() noexcept;
+
+    // Queues a read of `buf.size_bytes()` bytes from `fd` at `offset` into
+    // `buf`, or a write of its contents, calling `done` on completion.
+    void read(int fd, SecureBuffer &buf, uint64_t offset, Callback done);
+    void write(int fd, const SecureBuffer &buf, uint64_t offset, Callback done);
+
+    // Starts every queued operation. Throws `std::system_error` if the
+    // kernel rejects the batch; operations it had already taken stay in
+    // flight, the others stay queued for the next `submit()`.
+    void submit();
+
+    // Submits, then waits for at least `min_completions` operations (fewer if
+    // fewer are outstanding) and runs their callbacks.
+    // @return The number of callbacks run.
+    size_t wait(size_t min_completions = 1);
+
+    // Runs until nothing is queued or in flight, including operations queued
+    // by callbacks.
+    void drain();
+
+    // Operations queued or in flight.
+    size_t pending() const noexcept;
+
+private:
+    struct Op
+    {
+        int fd;
+        bool writing;
+        int fixed_index; // -1 unless the buffer is registered
+        uint64_t offset;
+        iovec iov;
+        Callback done;
+        ssize_t result;
+    };
+
+    struct Ring;
+    struct Workers;
+
+    void enqueue(int fd, bool writing, char *data, size_t len, uint64_t offset, Callback done);
+    void complete(unsigned slot) noexcept;
+    size_t reap(size_t min_completions);
+
+    std::vector<Op> ops;
+    std::vector<unsigned> free_slots;
+    std::vector<unsigned> queued;
+    size_t in_flight = 0;
+    std::unordered_map<const char *, int> fixed;
+    std::unique_ptr<Ring> ring;
+    std::unique_ptr<Workers> workers;
+};
+
+#endif // ASYNCIO_HPP
@@ -0,0 +1,36 @@
+#ifndef CONSTANTTIME_HPP
+#define CONSTANTTIME_HPP
+
+#include <cstddef>
+
+// Constant-time comparison kernels with one-time CPU dispatch.
+//
+// `consttime::equal` compares tokens, MACs and keys without leaking where
+// they differ: every byte is read, differences are OR-accumulated, and the
+// only branch depends on the length, never on the contents. The SSE2/AVX2
+// kernels process 16/32 bytes per step, so comparisons run at memory
+// bandwidth instead of `memcmp`'s early-exit speed.
+namespace consttime
+{
+    enum class Kernel
+    {
+        Scalar, // byte-at-a-time XOR/OR accumulation (portable baseline)
+        SSE2,   // 16-byte loads
+        AVX2    // 32-byte loads
+    };
+
+    // True if the `len` bytes at `a` and `b` are equal. The running time
+    // depends only on `len`.
+    bool equal(const void *a, const void *b, size_t len) noexcept;
+
+    // Same, with a specific kernel; unsupported kernels fall back to scalar.
+    bool equal_with(Kernel k, const void *a, const void *b, size_t len) noexcept;
+
+    bool is_supported(Kernel k) noexcept;
+
+    // The kernel `equal` is bound to (chosen once, on first use).
+    Kernel active_kernel() noexcept;
+    const char *kernel_name(Kernel k) noexcept;
+}
+
+#endif // CONSTANTTIME_HPP
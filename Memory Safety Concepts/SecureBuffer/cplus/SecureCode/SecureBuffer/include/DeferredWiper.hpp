@@ -0,0 +1,76 @@
+#ifndef DEFERREDWIPER_HPP
+#define DEFERREDWIPER_HPP
+
+#include "include/SecureBuffer.hpp"
+#include "include/SecureQueue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+
+// Opt-in background wiping for large SecureBuffers.
+//
+// Once enabled, destroying a SecureBuffer of at least `threshold` bytes moves
+// it into a bounded lock-free queue instead of wiping inline; a background
+// thread then wipes and frees it. The destroying thread only pays for a move
+// and a queue push, whatever the buffer size. Buffers in caller-owned memory
+// (`Storage::Resource`) and inline ones are always wiped in place. If the
+// queue is full the buffer is wiped synchronously as usual, so memory held by
+// pending wipes stays bounded. `flush()` waits until every queued buffer has been wiped and
+// freed; call it (or `disable()`) before shutdown or before relying on the
+// memory being clean. A fork()ed child starts with deferral disabled (the
+// wiper thread does not survive fork) and may call `enable()` again.
+class DeferredWiper
+{
+public:
+    static constexpr size_t DefaultThreshold = 1024 * 1024;
+    static constexpr size_t DefaultQueueCapacity = 64;
+
+    struct Stats
+    {
+        uint64_t deferred;  // buffers handed to the wiper thread
+        uint64_t fallbacks; // buffers wiped synchronously because the queue was full
+    };
+
+    // Process-wide wiper consulted by `SecureBuffer::~SecureBuffer`.
+    // Never destroyed; its thread lives until process exit.
+    static DeferredWiper &instance();
+
+    // Defers buffers of `threshold` bytes or more. The first call starts the
+    // wiper thread with a queue of `queue_capacity` buffers; later calls only
+    // change the threshold.
+    void enable(size_t threshold = DefaultThreshold, size_t queue_capacity = DefaultQueueCapacity);
+
+    // Stops deferring new buffers and waits for the queued ones.
+    void disable() noexcept;
+
+    // Blocks until every buffer queued so far has been wiped and freed.
+    void flush() noexcept;
+
+    bool enabled() const noexcept;
+    Stats stats() const noexcept;
+
+    // Called by the SecureBuffer destructor. Moves `buf` to the wiper thread
+    // and returns true if it qualifies; otherwise leaves it untouched.
+    bool try_defer(SecureBuffer &buf) noexcept;
+
+private:
+    DeferredWiper();
+    void run() noexcept;
+    void unpend() noexcept;
+    void reset_in_child() noexcept;
+
+    static constexpr size_t Disabled = SIZE_MAX;
+
+    std::atomic<size_t> threshold{Disabled};
+    std::unique_ptr<SecureQueue<SecureBuffer>> queue;
+    std::counting_semaphore<> ready{0};
+    std::atomic<size_t> pending{0};
+    std::atomic<uint64_t> deferred{0};
+    std::atomic<uint64_t> fallbacks{0};
+    std::mutex start_lock;
+};
+
+#endif // DEFERREDWIPER_HPP
@@ -0,0 +1,94 @@
+#ifndef FIXEDSECUREBUFFER_HPP
+#define FIXEDSECUREBUFFER_HPP
+
+#include "include/SecureBuffer.hpp"
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Anything that exposes its secret bytes like SecureBuffer does, so generic
+// code can accept either SecureBuffer or FixedSecureBuffer<N> as a template
+// parameter without virtual calls or type erasure.
+template <typename T>
+concept SecureBytes = requires(T &b, const T &cb) {
+    { b.data_ptr() } -> std::same_as<char *>;
+    { cb.data_ptr() } -> std::same_as<const char *>;
+    { cb.size_bytes() } -> std::same_as<size_t>;
+};
+
+// RAII secure buffer with a compile-time size.
+//
+// Storage is a `std::array` inside the object: no heap, no size field, and
+// the wipe is a fixed-size memset that the compiler expands into a handful
+// of stores for exactly N bytes, followed by a barrier so it is never elided.
+template <size_t N>
+class FixedSecureBuffer
+{
+private:
+    alignas(16) std::array<char, N> bytes{};
+
+    static constexpr void secure_wipe(std::array<char, N> &b) noexcept
+    {
+        if (std::is_constant_evaluated()) {
+            b.fill(0);
+            return;
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        std::memset(b.data(), 0, N);
+        // Tell the optimizer the zeroed bytes may still be read, so the
+        // memset cannot be dropped as a dead store before destruction.
+        __asm__ __volatile__("" : : "r"(b.data()) : "memory");
+#else
+        volatile char *p = b.data();
+        for (size_t i = 0; i < N; ++i)
+            p[i] = 0;
+#endif
+    }
+
+public:
+    constexpr FixedSecureBuffer() noexcept = default;
+
+    // Disable copying
+    FixedSecureBuffer(const FixedSecureBuffer &) = delete;
+    FixedSecureBuffer &operator=(const FixedSecureBuffer &) = delete;
+
+    // Moving copies the bytes and wipes the source, since they live inside
+    // the object and cannot be handed over by pointer.
+    constexpr FixedSecureBuffer(FixedSecureBuffer &&other) noexcept
+        : bytes(other.bytes)
+    {
+        secure_wipe(other.bytes);
+    }
+
+    constexpr FixedSecureBuffer &operator=(FixedSecureBuffer &&other) noexcept
+    {
+        if (this != &other) {
+            bytes = other.bytes;
+            secure_wipe(other.bytes);
+        }
+        return *this;
+    }
+
+    constexpr ~FixedSecureBuffer()
+    {
+        secure_wipe(bytes);
+    }
+
+    // Accessors (same interface as SecureBuffer)
+    constexpr char *data_ptr() noexcept { return bytes.data(); }
+    constexpr const char *data_ptr() const noexcept { return bytes.data(); }
+    constexpr size_t size_bytes() const noexcept { return N; }
+    static constexpr size_t capacity() noexcept { return N; }
+};
+
+static_assert(SecureBytes<SecureBuffer>);
+static_assert(SecureBytes<FixedSecureBuffer<32>>);
+
+// Common fixed-size secrets
+using Aes128Key = FixedSecureBuffer<16>;
+using Aes256Key = FixedSecureBuffer<32>;
+using GcmNonce = FixedSecureBuffer<12>;
+
+#endif // FIXEDSECUREBUFFER_HPP
@@ -0,0 +1,65 @@
+#ifndef FORKREPOPULATOR_HPP
+#define FORKREPOPULATOR_HPP
+
+#include "include/SecureBuffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Re-fills selected `Storage::WipeOnFork` buffers in a forked child.
+//
+// A prefork server loads its keys into `Storage::WipeOnFork` buffers before
+// forking; every child then starts with those pages zeroed by the kernel, so
+// nothing is copied and the child has nothing to wipe. Buffers a worker does
+// need are registered here with a loader (read the key from a pipe, an HSM,
+// a file only the worker may open, ...), and the child calls `repopulate()`
+// once after fork() to run them.
+//
+// Registrations are not owning: a registered buffer must not be moved or
+// destroyed until it is `forget`-ed.
+class ForkRepopulator
+{
+public:
+    // Called in the child with the registered buffer, whose bytes read as
+    // zero; it keeps its size and capacity.
+    using Loader = std::function<void(SecureBuffer &)>;
+
+    // Process-wide registry. Never destroyed.
+    static ForkRepopulator &instance();
+
+    // Registers `buf` to be re-filled by `loader` in children. Registering
+    // the same buffer again replaces its loader.
+    void add(SecureBuffer &buf, Loader loader);
+
+    // Drops the registration of `buf`, if any.
+    void forget(const SecureBuffer &buf) noexcept;
+
+    // Runs every registered loader, in registration order. Call it in the
+    // child after fork(); a loader that throws stops the run and the
+    // exception propagates.
+    // @return The number of buffers re-filled.
+    size_t repopulate();
+
+    size_t size() const noexcept;
+
+    // Number of fork()s between the first use of the registry and the
+    // calling process, counted by a pthread_atfork child handler: 0 in the
+    // original process, 1 in its children, and so on.
+    static uint64_t fork_generation() noexcept;
+
+private:
+    ForkRepopulator();
+
+    struct Entry
+    {
+        SecureBuffer *buf;
+        Loader loader;
+    };
+
+    mutable std::mutex lock;
+    std::vector<Entry> entries;
+};
+
+#endif // FORKREPOPULATOR_HPP
@@ -0,0 +1,164 @@
+#ifndef LOCKEDARENA_HPP
+#define LOCKEDARENA_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Page arena backed by mlock'ed, dump-excluded memory.
+//
+// Regions of up to `RegionBytes` are mapped, `mlock`ed and marked
+// `MADV_DONTDUMP` once, then carved into power-of-two blocks (64 B..64 KiB)
+// for many buffers, so individual allocations cost no syscall. Locked bytes
+// are accounted against a `Budget`, which the process-wide arenas share so
+// that together they stay within RLIMIT_MEMLOCK; when the budget or `mlock`
+// runs out, `allocate` returns nullptr and the caller falls back to unlocked
+// memory. A refusal the kernel will not lift (EPERM, ENOSYS) stops the
+// arena from mapping further regions; any other (e.g. ENOMEM over the limit)
+// is retried after `RetryInterval` requests.
+//
+// With `Source::Secret` the regions come from `memfd_secret` (Linux 5.14+)
+// instead: their pages are also removed from the kernel's direct map, so
+// neither other processes nor a kernel read primitive can reach them through
+// the linear mapping. The syscall and mapping are paid once per region; the
+// blocks are handed out exactly like locked ones. `Source::WipeOnFork`
+// regions are locked like `Source::Locked` and also `MADV_WIPEONFORK`, so a
+// forked child sees zero pages where the parent kept its secrets. The free
+// list heads live outside the regions and survive the fork, but the links
+// stored in the freed blocks read as null there, so each list is cut short
+// after its first block in the child (leaking the rest, never corrupting).
+class LockedArena
+{
+public:
+    static constexpr size_t MinBlock = 64;
+    static constexpr size_t MaxBlock = 64 * 1024;
+    static constexpr size_t RegionBytes = 1024 * 1024;
+    static constexpr unsigned RetryInterval = 64;
+
+    // Where regions come from.
+    enum class Source : unsigned char
+    {
+        Locked, // anonymous mapping, `mlock`ed and `MADV_DONTDUMP`ed
+        Secret, // `memfd_secret` mapping, unmapped from the kernel direct map
+        WipeOnFork // like `Locked`, plus `MADV_WIPEONFORK`
+    };
+
+    // Locked bytes that one or more arenas draw their regions from. Must
+    // outlive every arena using it.
+    class Budget
+    {
+    public:
+        explicit Budget(size_t limit_bytes) noexcept;
+
+        Budget(const Budget &) = delete;
+        Budget &operator=(const Budget &) = delete;
+
+        // Takes the largest multiple of `unit` up to `max_bytes` that is still
+        // available, if that is at least `min_bytes`.
+        // @return Bytes taken, or 0.
+        size_t reserve(size_t min_bytes, size_t max_bytes, size_t unit) noexcept;
+
+        // Returns bytes taken with `reserve`.
+        void give_back(size_t bytes) noexcept;
+
+        size_t limit() const noexcept;
+        size_t used() const noexcept;
+
+    private:
+        const size_t limit_bytes;
+        std::atomic<size_t> used_bytes{0};
+    };
+
+    struct Stats
+    {
+        size_t budget;        // limit of the budget this arena draws from
+        size_t locked_bytes;  // bytes currently locked in regions
+        size_t regions;       // number of mapped regions
+        uint64_t allocations; // blocks handed out
+        uint64_t fallbacks;   // requests refused (too large or over budget)
+    };
+
+    // @param budget_bytes Maximum number of bytes to lock.
+    // @param source Where to map regions from.
+    explicit LockedArena(size_t budget_bytes, Source source = Source::Locked);
+
+    // Same, drawing from `budget` together with any other arena using it.
+    explicit LockedArena(Budget &budget, Source source = Source::Locked);
+    ~LockedArena();
+
+    LockedArena(const LockedArena &) = delete;
+    LockedArena &operator=(const LockedArena &) = delete;
+
+    // Budget shared by the three process-wide arenas: the soft
+    // RLIMIT_MEMLOCK at first use. Never destroyed.
+    static Budget &shared_budget();
+
+    // Process-wide arena used by `SecureBuffer(size, Storage::Locked)`,
+    // drawing from `shared_budget()`. Never destroyed.
+    static LockedArena &instance();
+
+    // Process-wide `Source::Secret` arena used by
+    // `SecureBuffer(size, Storage::Secret)`, drawing from the same budget
+    // (secret memory counts against RLIMIT_MEMLOCK too). Never destroyed.
+    static LockedArena &secret_instance();
+
+    // Whether the kernel offers `memfd_secret` (probed once). When it does
+    // not, a `Source::Secret` arena refuses every request.
+    static bool secret_supported() noexcept;
+
+    // Process-wide `Source::WipeOnFork` arena used by
+    // `SecureBuffer(size, Storage::WipeOnFork)`, drawing from the same
+    // budget. Never destroyed.
+    static LockedArena &fork_instance();
+
+    static bool fits(size_t n) noexcept;
+    static size_t block_size(size_t n) noexcept;
+
+    // Returns a zeroed, locked block of `block_size(n)` bytes, or nullptr if
+    // the request cannot be served from locked memory.
+    char *allocate(size_t n) noexcept;
+
+    // Returns a block obtained from `allocate(n)`. The block must already be
+    // wiped by the caller.
+    void release(char *p, size_t n) noexcept;
+
+    Stats stats() const noexcept;
+    Source source() const noexcept;
+
+private:
+    static constexpr size_t NumClasses = 11; // 64, 128, ..., 64 KiB
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct Region
+    {
+        char *base;
+        size_t length;
+    };
+
+    static size_t class_index(size_t n) noexcept;
+    bool map_region(size_t min_bytes) noexcept;
+    char *map_pages(size_t length) noexcept;
+
+    mutable std::mutex lock;
+    std::array<FreeBlock *, NumClasses> free_lists{};
+    std::vector<Region> regions;
+    char *bump = nullptr;
+    char *bump_end = nullptr;
+    Budget own_budget;
+    Budget &budget;
+    const Source region_source;
+    size_t locked_bytes = 0;
+    unsigned retry_in = 0;   // region requests to refuse before retrying
+    bool map_disabled = false;
+    uint64_t allocations = 0;
+    uint64_t fallbacks = 0;
+};
+
+#endif // LOCKEDARENA_HPP
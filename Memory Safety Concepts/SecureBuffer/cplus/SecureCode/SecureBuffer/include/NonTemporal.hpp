@@ -0,0 +1,33 @@
+#ifndef NONTEMPORAL_HPP
+#define NONTEMPORAL_HPP
+
+#include <cstddef>
+
+// Non-temporal (streaming) bulk stores.
+//
+// Regular stores pull every written line into the cache hierarchy, so
+// wiping or filling a buffer much larger than the cache evicts whatever hot
+// working set was there. Streaming stores go to memory through write-combining
+// buffers and leave the caches alone. `securewipe::wipe` and
+// `SecureBuffer::write` switch to them automatically from `threshold()`
+// bytes, which defaults to half of the last-level cache.
+namespace nontemporal
+{
+    // Size from which bulk wipes and writes use streaming stores.
+    size_t threshold() noexcept;
+
+    // Overrides the threshold (0 restores the cache-derived default).
+    void set_threshold(size_t bytes) noexcept;
+
+    // Zeroes `len` bytes at `ptr` with streaming stores. Like the temporal
+    // wipe kernels it ends with a compiler barrier, so the stores are never
+    // removed as dead, and with a store fence, so they are globally visible
+    // before it returns.
+    void zero(void *ptr, size_t len) noexcept;
+
+    // Copies `len` bytes from `src` to `dst` with streaming stores.
+    // The ranges must not overlap.
+    void copy(void *dst, const void *src, size_t len) noexcept;
+}
+
+#endif // NONTEMPORAL_HPP
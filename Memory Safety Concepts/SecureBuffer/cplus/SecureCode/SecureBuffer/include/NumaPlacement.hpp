@@ -0,0 +1,39 @@
+#ifndef NUMAPLACEMENT_HPP
+#define NUMAPLACEMENT_HPP
+
+#include <cstddef>
+
+// NUMA placement through the raw mbind / get_mempolicy / getcpu system calls
+// (no libnuma dependency).
+//
+// Placement uses MPOL_PREFERRED: pages are faulted in on the chosen node and
+// only spill to another node when that one is out of memory, so a bad node
+// choice costs latency, never an allocation failure. On kernels or builds
+// without NUMA support every call degrades to "node 0, nothing to do".
+namespace numa
+{
+    // Largest node id that can be targeted (one 64-bit node mask).
+    constexpr int MaxNodes = 64;
+
+    // Number of online nodes (at least 1).
+    int node_count() noexcept;
+
+    // Node of the CPU the calling thread is running on (0 if unknown).
+    int current_node() noexcept;
+
+    // Sets the placement policy of the page-aligned range [p, p + len) to
+    // prefer `node`. Pages already faulted in are migrated where possible.
+    // @return False if the kernel rejected the policy.
+    bool bind(void *p, size_t len, int node) noexcept;
+
+    // Node currently holding the page at `p` (which must be faulted in), or
+    // -1 if it cannot be determined.
+    int node_of(const void *p) noexcept;
+
+    // `pagealloc::map_zeroed(n)` with its pages preferring `node`.
+    // Throws `std::bad_alloc` if the mapping fails; an unknown node leaves
+    // the mapping with the default policy.
+    char *map_on_node(size_t n, int node);
+}
+
+#endif // NUMAPLACEMENT_HPP
@@ -0,0 +1,66 @@
+#ifndef PAGEALLOCATOR_HPP
+#define PAGEALLOCATOR_HPP
+
+#include <cstddef>
+
+// Thin wrappers over anonymous page mappings.
+//
+// Fresh anonymous mappings are backed by the kernel's shared zero page until
+// first written, so a mapped buffer is zero without the process writing a
+// single byte.
+namespace pagealloc
+{
+    size_t page_size() noexcept;
+
+    // Rounds `n` up to a whole number of pages.
+    size_t round_up(size_t n) noexcept;
+
+    // Maps `round_up(n)` bytes of zeroed, private anonymous memory.
+    // `n == 0` maps nothing and returns nullptr, like an empty allocation.
+    // Throws `std::bad_alloc` if the mapping fails.
+    char *map_zeroed(size_t n);
+
+    // Unmaps memory returned by `map_zeroed(n)` or `map_huge(n, ...)`.
+    void unmap(char *p, size_t n) noexcept;
+
+    // Drops the pages of [p, p + n) (both page-aligned) with
+    // MADV_DONTNEED. Private anonymous pages read back as zero afterwards,
+    // so this "wipes" them without a single user-space store; the freed
+    // frames are zeroed by the kernel before anyone else can map them.
+    // @return False if the kernel refused (the caller must wipe by hand).
+    bool discard(char *p, size_t n) noexcept;
+
+    // Marks [p, p + n) (both page-aligned) MADV_WIPEONFORK (Linux 4.14+):
+    // a child created by fork() sees these pages as fresh zero pages instead
+    // of copy-on-write copies of the parent's.
+    // @return False if the kernel does not support it.
+    bool wipe_on_fork(char *p, size_t n) noexcept;
+
+    // What a huge-page mapping ended up backed by.
+    enum class Backing : unsigned char
+    {
+        Pages,       // ordinary base pages
+        Transparent, // 2 MiB aligned, MADV_HUGEPAGE (transparent huge pages)
+        HugeTlb2M,   // MAP_HUGETLB, 2 MiB pages from the hugetlbfs pool
+        HugeTlb1G    // MAP_HUGETLB | MAP_HUGE_1GB, 1 GiB pages
+    };
+
+    constexpr size_t HugePageSize = size_t(2) << 20;
+    constexpr size_t GigaPageSize = size_t(1) << 30;
+
+    // Rounds `n` up to a whole number of 2 MiB pages (1 GiB pages for
+    // `HugeTlb1G`). This is the length `map_huge` maps.
+    size_t round_up_huge(size_t n, Backing backing = Backing::HugeTlb2M) noexcept;
+
+    // Maps zeroed memory for `n` bytes on the largest page size available:
+    // explicit 1 GiB pages for sizes of at least 1 GiB, then explicit 2 MiB
+    // pages, then a 2 MiB aligned transparent-huge-page mapping, and finally
+    // ordinary pages. `backing` receives the choice; the mapping is
+    // `round_up_huge(n, backing)` bytes long.
+    // Throws `std::bad_alloc` if even the ordinary mapping fails.
+    char *map_huge(size_t n, Backing &backing);
+
+    const char *backing_name(Backing backing) noexcept;
+}
+
+#endif // PAGEALLOCATOR_HPP
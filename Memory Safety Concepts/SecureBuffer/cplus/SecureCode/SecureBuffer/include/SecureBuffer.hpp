@@ -2,20 +2,110 @@
 #define SECUREBUFFER_HPP
 
 #include <memory>
+#include <memory_resource>
 #include <cstddef> // for std::byte
+#include <cstdint>
+#include "include/PageAllocator.hpp"
+#include "include/SecureSpan.hpp"
+
+class WipeThreadPool;
+
+// Size from which the default constructor maps zero pages instead of using
+// the heap (override with -DSECUREBUFFER_MAPPED_THRESHOLD=<bytes>).
+#ifndef SECUREBUFFER_MAPPED_THRESHOLD
+#define SECUREBUFFER_MAPPED_THRESHOLD (64 * 1024)
+#endif
+
+// Wipes of at least this many bytes in `Storage::Mapped` buffers drop the
+// pages with MADV_DONTNEED instead of writing zeros
+// (override with -DSECUREBUFFER_DISCARD_THRESHOLD=<bytes>).
+#ifndef SECUREBUFFER_DISCARD_THRESHOLD
+#define SECUREBUFFER_DISCARD_THRESHOLD (1024 * 1024)
+#endif
+
+// Buffers of up to this many bytes are stored inside the object by default
+// (override with -DSECUREBUFFER_INLINE_CAPACITY=<bytes>, 0 disables it).
+#ifndef SECUREBUFFER_INLINE_CAPACITY
+#define SECUREBUFFER_INLINE_CAPACITY 64
+#endif
 
 // RAII Secure Buffer
 class SecureBuffer
 {
+public:
+    // Where the buffer's bytes come from.
+    enum class Storage : unsigned char
+    {
+        Heap,  // global allocator (`new[]`)
+        Pool,  // size-class slab pool (`SecurePool`), 1..4096 bytes
+        Locked, // mlock'ed, dump-excluded arena (`LockedArena`), 1..64 KiB
+        Mapped, // private anonymous mapping, zeroed by the kernel
+        Inline, // inside the SecureBuffer object itself (small buffers)
+        Resource, // caller-supplied `std::pmr::memory_resource`
+        Huge,   // 2 MiB / 1 GiB pages (`pagealloc::map_huge`), 2 MiB and up
+        Numa,   // placed on one NUMA node: `SecurePool::for_node` or mapped pages
+        Secret, // `memfd_secret` arena (`LockedArena::secret_instance`), 1..64 KiB
+        WipeOnFork // `MADV_WIPEONFORK` pages: zero in fork()ed children
+    };
+
 private:
-    std::unique_ptr<char[]> data;
+    // Returns the storage to where it was allocated from. The owning
+    // SecureBuffer wipes the bytes before the deleter runs.
+    struct StorageDeleter
+    {
+        Storage storage = Storage::Heap;
+        pagealloc::Backing backing = pagealloc::Backing::Pages; // Storage::Huge only
+        short node = -1; // Storage::Numa only
+        bool mapped = false; // Storage::WipeOnFork only: own mapping, not an arena block
+        bool resource_wipes = false; // Storage::Resource only: see SecureWipingResource::wipes_buffers
+        size_t capacity = 0;
+        std::pmr::memory_resource *resource = nullptr; // Storage::Resource only
+
+        void operator()(char *p) const noexcept;
+    };
+
+    std::unique_ptr<char[], StorageDeleter> data;
     size_t size;
 
+    // Storage for `Storage::Inline`; unused (and left uninitialized) otherwise.
+    alignas(16) char inline_data[SECUREBUFFER_INLINE_CAPACITY > 0 ? SECUREBUFFER_INLINE_CAPACITY : 1];
+
     static void secure_wipe(void *ptr, size_t len) noexcept;
+    bool discards(size_t len) const noexcept;
+    void wipe_storage(char *ptr, size_t len) noexcept;
+    static std::unique_ptr<char[], StorageDeleter> allocate(size_t s, Storage storage,
+                                                            std::pmr::memory_resource *mr = nullptr,
+                                                            int node = -1);
+    void take_inline(SecureBuffer &other) noexcept;
+    Storage growth_storage(size_t cap) const noexcept;
+    void reallocate(size_t new_cap);
+    size_t grown_capacity(size_t needed) const;
+    void storage_changed() noexcept;
 
 public:
+    // Buffers of at least this many bytes default to `Storage::Mapped`.
+    static constexpr size_t MappedThreshold = SECUREBUFFER_MAPPED_THRESHOLD;
+
+    // Mapped wipes of at least this many bytes are done by the kernel.
+    static constexpr size_t DiscardThreshold = SECUREBUFFER_DISCARD_THRESHOLD;
+
+    // Buffers of at most this many bytes default to `Storage::Inline`.
+    static constexpr size_t InlineCapacity = SECUREBUFFER_INLINE_CAPACITY;
+
     explicit SecureBuffer(size_t s);
 
+    // Allocates from the requested storage. Sizes the storage cannot serve
+    // fall back to the heap; `storage()` reports what was actually used.
+    // `node` selects the NUMA node for `Storage::Numa` (-1: the node of the
+    // calling thread's CPU) and is ignored otherwise.
+    SecureBuffer(size_t s, Storage storage, int node = -1);
+
+    // Allocates from a polymorphic memory resource (e.g. a per-request
+    // `std::pmr::monotonic_buffer_resource`). The buffer is still wiped on
+    // destruction before the bytes are handed back to `mr`, unless `mr` is
+    // covered by a `SecureWipingResource` with `BufferWipe::OnRelease`.
+    SecureBuffer(size_t s, std::pmr::memory_resource *mr);
+
     // Disable copying
     SecureBuffer(const SecureBuffer &) = delete;
     SecureBuffer &operator=(const SecureBuffer &) = delete;
@@ -26,10 +116,65 @@ public:
 
     ~SecureBuffer();
 
+    // Largest size a buffer can be asked for, as for std::vector.
+    static constexpr size_t max_size() noexcept { return PTRDIFF_MAX; }
+
+    // Growth. Every reallocation wipes the old block before freeing it.
+    // Sizes beyond `max_size()` throw `std::length_error`.
+    void reserve(size_t n);
+    void resize(size_t n);
+    void append(const void *src, size_t len);
+
+    // Wipes the contents across a thread pool and empties the buffer, like
+    // `resize(0)`; the capacity is kept, so it can be refilled without
+    // reallocating. Returns once every byte is zero.
+    void parallel_wipe();
+    void parallel_wipe(WipeThreadPool &pool);
+
+    // Copies `len` bytes from `src` to [offset, offset + len), which must lie
+    // within the buffer (throws `std::out_of_range` otherwise). Copies of at
+    // least `nontemporal::threshold()` bytes bypass the cache.
+    void write(size_t offset, const void *src, size_t len);
+
+    // Reads from `fd` straight into the storage until the current size is
+    // filled or the input ends; writes the contents to `fd`. Partial
+    // transfers are resumed and errors throw `std::system_error`; see
+    // SecureIO.hpp for batches of buffers in one syscall.
+    // @return Bytes transferred (a short read means end of file).
+    size_t read_from(int fd);
+    size_t write_to(int fd) const;
+
     // Accessors
     char *data_ptr() noexcept;
     const char *data_ptr() const noexcept;
     size_t size_bytes() const noexcept;
+    size_t capacity() const noexcept;
+
+    // Constant-time comparison of the contents (`consttime::equal`), for
+    // tokens and MACs. Different sizes compare unequal; otherwise the running
+    // time depends only on the size, never on where the bytes differ.
+    bool constant_time_equal(const SecureBuffer &other) const noexcept;
+    bool constant_time_equal(const void *bytes, size_t len) const noexcept;
+
+    // Zero-copy views over the current contents. Views are invalidated by
+    // anything that moves or shrinks the storage (move, reserve, resize,
+    // append, destruction); define SECUREBUFFER_DEBUG_VIEWS to catch misuse.
+    SecureSpan span() noexcept;
+    SecureConstSpan span() const noexcept;
+    Storage storage() const noexcept;
+
+    // The page size backing the buffer: a huge-page kind for `Storage::Huge`,
+    // `Backing::Pages` for every other storage.
+    pagealloc::Backing page_backing() const noexcept;
+
+    // Whether wiping this buffer may drop its pages with MADV_DONTNEED instead
+    // of writing zeros (large `Storage::Mapped`, transparent huge pages). Such
+    // memory must not be pinned by the kernel, e.g. as an io_uring fixed
+    // buffer: the process would fault in fresh pages behind the pinned ones.
+    bool discards_pages() const noexcept;
+
+    // The NUMA node a `Storage::Numa` buffer was placed on, -1 otherwise.
+    int numa_node() const noexcept;
 };
 
-#endif // SECUREBUFFER_HPP
\ No newline at end of file
+#endif // SECUREBUFFER_HPP
@@ -0,0 +1,31 @@
+#ifndef SECUREIO_HPP
+#define SECUREIO_HPP
+
+#include "include/SecureBuffer.hpp"
+#include <cstddef>
+#include <span>
+
+// Scatter/gather I/O straight between file descriptors and SecureBuffers.
+//
+// Reading a secret through a stack array or `std::string` leaves a staging
+// copy nobody wipes. These functions hand the buffers' own storage to
+// `readv`/`writev`, so the bytes exist only in the SecureBuffers, and a
+// whole batch of buffers moves in one syscall (up to IOV_MAX buffers per
+// call). Short transfers and EINTR are retried until every byte has moved;
+// other errors throw `std::system_error` with the errno.
+namespace secureio
+{
+    // Fills each buffer, in order, over its current size from `fd`.
+    // @return Bytes read; less than the total size only at end of file.
+    size_t read_from(int fd, std::span<SecureBuffer> bufs);
+
+    // Writes every buffer's contents to `fd`, in order.
+    // @return Bytes written (always the total size).
+    size_t write_to(int fd, std::span<const SecureBuffer> bufs);
+
+    // Single-range forms used by `SecureBuffer::read_from`/`write_to`.
+    size_t read_from(int fd, void *dst, size_t len);
+    size_t write_to(int fd, const void *src, size_t len);
+}
+
+#endif // SECUREIO_HPP
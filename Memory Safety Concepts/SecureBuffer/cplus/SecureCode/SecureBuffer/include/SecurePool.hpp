@@ -0,0 +1,150 @@
+#ifndef SECUREPOOL_HPP
+#define SECUREPOOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Size-class slab pool for small secret buffers.
+//
+// Blocks are carved from 64 KiB slabs into power-of-two classes from
+// 32 to 4096 bytes. Released blocks must already be wiped by the caller;
+// they go back onto a per-class free list and are handed out again without
+// touching the global allocator.
+//
+// The global instance also keeps a per-thread magazine cache in front of the
+// shared free lists, in the style of tcmalloc: each thread allocates from and
+// releases into its own magazine of up to `MagazineSize` wiped blocks per
+// class without locking. A block freed on a different thread than the one
+// that allocated it simply lands in the freeing thread's magazine, so
+// cross-thread returns are lock-free too. Only when a magazine runs empty or
+// overflows is half of it exchanged with the shared list, under that class's
+// lock, so the lock is taken once per `MagazineSize / 2` operations.
+//
+// `for_node(n)` returns a separate pool per NUMA node whose slabs are
+// placed on node `n`, so each node keeps its own free lists and a block
+// never migrates to another node's list. Node pools have no thread caches.
+class SecurePool
+{
+public:
+    static constexpr size_t MinBlock = 32;
+    static constexpr size_t MaxBlock = 4096;
+    static constexpr size_t SlabBytes = 64 * 1024;
+    static constexpr size_t MagazineSize = 32;
+
+    struct Stats
+    {
+        uint64_t hits;     // allocations served from a magazine or free list
+        uint64_t misses;   // allocations that had to carve a new slab
+        uint64_t releases; // blocks returned to the pool
+    };
+
+    // A pool without thread caches; every operation takes the class lock.
+    SecurePool() = default;
+    ~SecurePool();
+
+    SecurePool(const SecurePool &) = delete;
+    SecurePool &operator=(const SecurePool &) = delete;
+
+    // Process-wide pool used by `SecureBuffer(size, Storage::Pool)`, with
+    // per-thread magazines. Intentionally never destroyed, so buffers with
+    // static storage duration can still release into it during exit.
+    static SecurePool &instance();
+
+    // Process-wide pool for NUMA node `node` (clamped to the online nodes),
+    // used by `SecureBuffer(size, Storage::Numa, node)`. Never destroyed.
+    static SecurePool &for_node(int node);
+
+    // True if `n` bytes can be served from one of the size classes.
+    static bool fits(size_t n) noexcept;
+
+    // Rounds `n` up to its size class (the usable size of the block).
+    static size_t block_size(size_t n) noexcept;
+
+    // Returns a zeroed block of `block_size(n)` bytes.
+    // Throws `std::bad_alloc` if a new slab cannot be allocated.
+    char *allocate(size_t n);
+
+    // Returns a block obtained from `allocate(n)`. The block must already be
+    // wiped; only the free-list link is written into it.
+    void release(char *p, size_t n) noexcept;
+
+    // Totals across the shared lists and every live thread cache.
+    Stats stats() const noexcept;
+
+private:
+    static constexpr size_t NumClasses = 8; // 32, 64, ..., 4096
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct SizeClass
+    {
+        mutable std::mutex lock;
+        FreeBlock *free_list = nullptr;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t releases = 0;
+    };
+
+    // One thread's magazines. Counters are written only by the owning thread
+    // (relaxed store, no read-modify-write) and summed by `stats()`.
+    struct ThreadCache
+    {
+        struct Magazine
+        {
+            uint32_t count = 0;
+            FreeBlock *blocks[MagazineSize];
+        };
+
+        std::array<Magazine, NumClasses> magazines;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> releases{0};
+    };
+
+    // Thread-exit hook: flushes the thread's magazines back to the shared
+    // lists. `tls_exited` is trivially destructible, so releases issued after
+    // the owner is gone (static destructors) can still see it and bypass
+    // the cache.
+    struct ThreadCacheOwner
+    {
+        ThreadCache *cache = nullptr;
+        ~ThreadCacheOwner();
+    };
+    static thread_local ThreadCacheOwner tls_owner;
+    static thread_local bool tls_exited;
+
+    explicit SecurePool(bool thread_caches, int node = -1);
+
+    static size_t class_index(size_t n) noexcept;
+    void refill(SizeClass &sc, size_t block);
+    char *allocate_shared(size_t idx);
+    void release_shared(size_t idx, FreeBlock *b) noexcept;
+    ThreadCache *thread_cache() noexcept;
+    bool refill_magazine(ThreadCache::Magazine &mag, size_t idx);
+    void flush_magazine(ThreadCache::Magazine &mag, size_t idx, uint32_t keep) noexcept;
+    void retire_thread_cache(ThreadCache *tc) noexcept;
+
+    char *allocate_slab();
+    void free_slab(char *slab) noexcept;
+
+    std::array<SizeClass, NumClasses> classes;
+    std::mutex slabs_lock;
+    std::vector<char *> slabs;
+
+    const bool use_thread_caches = false;
+    const int node = -1;                // NUMA node of the slabs, -1 = any
+    mutable std::mutex caches_lock;
+    std::vector<ThreadCache *> caches;  // live thread caches, for stats()
+    uint64_t retired_hits = 0;          // counters of exited threads
+    uint64_t retired_misses = 0;
+    uint64_t retired_releases = 0;
+};
+
+#endif // SECUREPOOL_HPP
@@ -0,0 +1,127 @@
+#ifndef SECUREQUEUE_HPP
+#define SECUREQUEUE_HPP
+
+#include "include/SecureWipe.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free multi-producer/multi-consumer queue for move-only secret
+// holders such as SecureBuffer and FixedSecureBuffer<N>. Any nothrow move
+// constructible type works (the SecureString project's `SecureString`
+// qualifies), but only the SecureBuffer types are tested here, since
+// SecureString is built separately.
+//
+// This is Dmitry Vyukov's bounded MPMC array queue: every cell carries a
+// sequence number that tells producers and consumers whose turn it is, so a
+// push or pop is one CAS on the shared index plus plain stores into the cell,
+// with no locks and no per-element allocation. Elements are moved in and out
+// of the cells; after an element is moved out, the cell's bytes are wiped
+// so a vacated slot never retains any part of the secret (inline bytes,
+// pointers or sizes).
+template <typename T>
+class SecureQueue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "SecureQueue elements must be nothrow move constructible");
+
+public:
+    // @param capacity Maximum number of queued elements, rounded up to a
+    //                 power of two (at least 2).
+    explicit SecureQueue(size_t capacity)
+        : mask(round_up_pow2(capacity) - 1), cells(new Cell[mask + 1])
+    {
+        for (size_t i = 0; i <= mask; ++i){
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    SecureQueue(const SecureQueue &) = delete;
+    SecureQueue &operator=(const SecureQueue &) = delete;
+
+    // Destroys (and thereby wipes) any elements still queued.
+    ~SecureQueue()
+    {
+        while (try_pop()){
+        }
+    }
+
+    // Moves `value` into the queue. Returns false, leaving `value` untouched,
+    // if the queue is full.
+    bool try_push(T &&value) noexcept
+    {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;){
+            Cell &cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0){
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    ::new (static_cast<void *>(cell.storage)) T(std::move(value));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0){
+                return false; // full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Moves the oldest element out of the queue, or returns nullopt if empty.
+    std::optional<T> try_pop() noexcept
+    {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;){
+            Cell &cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0){
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    T *slot = std::launder(reinterpret_cast<T *>(cell.storage));
+                    std::optional<T> out(std::move(*slot));
+                    slot->~T();
+                    securewipe::wipe(cell.storage, sizeof(T));
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return out;
+                }
+            } else if (diff < 0){
+                return std::nullopt; // empty
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t capacity() const noexcept { return mask + 1; }
+
+private:
+    static constexpr size_t CacheLine = 64;
+
+    struct alignas(CacheLine) Cell
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static size_t round_up_pow2(size_t n) noexcept
+    {
+        size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    // Producer and consumer indices on separate cache lines.
+    alignas(CacheLine) std::atomic<size_t> enqueue_pos{0};
+    alignas(CacheLine) std::atomic<size_t> dequeue_pos{0};
+    alignas(CacheLine) const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+};
+
+#endif // SECUREQUEUE_HPP
@@ -0,0 +1,133 @@
+#ifndef SECURESPAN_HPP
+#define SECURESPAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+// Debug-only lifetime tracking for views (define SECUREBUFFER_DEBUG_VIEWS,
+// e.g. `make DEBUG=1`). Every SecureBuffer is registered with a generation
+// number that changes whenever its storage moves, shrinks or dies; a view
+// remembers the generation it was made from and aborts on access if it no
+// longer matches. The functions are always built but only called when the
+// macro is defined, and the macro must be used consistently across a program.
+namespace secureview_debug
+{
+    void attach(const void *owner) noexcept;
+    void detach(const void *owner) noexcept;
+    uint64_t generation(const void *owner) noexcept;
+    void check(const void *owner, uint64_t generation) noexcept;
+}
+
+// Non-owning, trivially copyable view over (part of) a SecureBuffer.
+//
+// Views never copy or wipe: they are plain pointer + length pairs meant to be
+// passed between parsing stages. `subspan`, `first`, `last` and `at` are bounds
+// checked and throw `std::out_of_range`; `operator[]` is not.
+template <typename Byte>
+class BasicSecureSpan
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    constexpr BasicSecureSpan() noexcept = default;
+
+    BasicSecureSpan(Byte *p, size_t n, [[maybe_unused]] const void *owner = nullptr) noexcept
+        : ptr(p), len(n)
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+        , owner(owner), gen(owner ? secureview_debug::generation(owner) : 0)
+#endif
+    {
+    }
+
+    // A mutable view converts to a read-only one.
+    template <typename Other>
+        requires(std::is_const_v<Byte> && std::is_same_v<const Other, Byte>)
+    BasicSecureSpan(const BasicSecureSpan<Other> &other) noexcept
+        : ptr(other.ptr), len(other.len)
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+        , owner(other.owner), gen(other.gen)
+#endif
+    {
+    }
+
+    Byte *data() const noexcept
+    {
+        validate();
+        return ptr;
+    }
+    size_t size() const noexcept { return len; }
+    bool empty() const noexcept { return len == 0; }
+
+    Byte &operator[](size_t i) const noexcept { return data()[i]; }
+
+    Byte &at(size_t i) const
+    {
+        if (i >= len)
+            throw std::out_of_range("SecureSpan::at: index out of range");
+        return data()[i];
+    }
+
+    Byte *begin() const noexcept { return data(); }
+    Byte *end() const noexcept { return data() + len; }
+
+    // [offset, offset + count), or to the end when `count` is npos.
+    BasicSecureSpan subspan(size_t offset, size_t count = npos) const
+    {
+        if (offset > len)
+            throw std::out_of_range("SecureSpan::subspan: offset out of range");
+        if (count == npos)
+            count = len - offset;
+        if (count > len - offset)
+            throw std::out_of_range("SecureSpan::subspan: count out of range");
+        BasicSecureSpan s = *this;
+        s.ptr = data() + offset;
+        s.len = count;
+        return s;
+    }
+
+    BasicSecureSpan first(size_t count) const { return subspan(0, count); }
+    BasicSecureSpan last(size_t count) const
+    {
+        if (count > len)
+            throw std::out_of_range("SecureSpan::last: count out of range");
+        return subspan(len - count, count);
+    }
+
+    std::span<Byte> as_span() const noexcept { return {data(), len}; }
+
+    std::string_view as_string_view() const noexcept
+    {
+        return {reinterpret_cast<const char *>(data()), len};
+    }
+
+private:
+    template <typename>
+    friend class BasicSecureSpan;
+
+    void validate() const noexcept
+    {
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+        if (owner)
+            secureview_debug::check(owner, gen);
+#endif
+    }
+
+    Byte *ptr = nullptr;
+    size_t len = 0;
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+    const void *owner = nullptr;
+    uint64_t gen = 0;
+#endif
+};
+
+using SecureSpan = BasicSecureSpan<std::byte>;
+using SecureConstSpan = BasicSecureSpan<const std::byte>;
+
+static_assert(std::is_trivially_copyable_v<SecureSpan>);
+static_assert(std::is_trivially_copyable_v<SecureConstSpan>);
+
+#endif // SECURESPAN_HPP
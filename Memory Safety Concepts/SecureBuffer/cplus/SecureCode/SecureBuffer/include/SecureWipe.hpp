@@ -0,0 +1,36 @@
+#ifndef SECUREWIPE_HPP
+#define SECUREWIPE_HPP
+
+#include <cstddef>
+
+// Vectorized secure wipe kernels with one-time CPU dispatch.
+//
+// `securewipe::wipe` is the entry point used by SecureBuffer. The first call
+// queries CPUID and binds the widest kernel the CPU (and OS) supports; every
+// later call goes straight through the cached function pointer.
+namespace securewipe
+{
+    enum class Kernel
+    {
+        Scalar, // byte-at-a-time volatile loop (portable baseline)
+        SSE2,   // 16-byte stores
+        AVX2,   // 32-byte stores
+        AVX512  // 64-byte stores
+    };
+
+    // Zeroes `len` bytes at `ptr` using the dispatched kernel, or with
+    // streaming stores from `nontemporal::threshold()` bytes on.
+    void wipe(void *ptr, size_t len) noexcept;
+
+    // Zeroes `len` bytes at `ptr` using a specific kernel.
+    // Falls back to the scalar kernel if `k` is not supported on this CPU.
+    void wipe_with(Kernel k, void *ptr, size_t len) noexcept;
+
+    bool is_supported(Kernel k) noexcept;
+
+    // The kernel `wipe` is bound to (chosen once, on first use).
+    Kernel active_kernel() noexcept;
+    const char *kernel_name(Kernel k) noexcept;
+}
+
+#endif // SECUREWIPE_HPP
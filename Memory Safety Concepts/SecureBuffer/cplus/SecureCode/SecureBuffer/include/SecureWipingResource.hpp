@@ -0,0 +1,57 @@
+#ifndef SECUREWIPINGRESOURCE_HPP
+#define SECUREWIPINGRESOURCE_HPP
+
+#include <memory_resource>
+
+// Memory resource adapter that wipes every block before returning it upstream.
+//
+// Use it as the upstream of a request-scoped arena so that everything the
+// arena handed out is wiped, one pass per chunk, when the arena is released.
+// That includes memory owned by pmr containers rather than SecureBuffers:
+//
+//     SecureWipingResource wiping;
+//     std::pmr::monotonic_buffer_resource arena(&wiping);
+//     SecureBuffer token(48, &arena);   // wiped on destruction; deallocation is a no-op
+//     ...
+//     arena.release();                  // wipe + free of every chunk
+//
+// By default SecureBuffers still wipe themselves on destruction, so their
+// bytes are zeroed twice. With `BufferWipe::OnRelease` they skip that wipe
+// and the release pass is the only one: hundreds of buffers are destroyed in
+// O(1) each and wiped together by `release()`. Their secrets then stay in
+// memory until the arena is released, and the arena must not be given an
+// initial buffer of its own (those bytes never reach this resource).
+class SecureWipingResource : public std::pmr::memory_resource
+{
+public:
+    // Who wipes a SecureBuffer allocated through this resource, either
+    // directly or from a `std::pmr::monotonic_buffer_resource` on top of it.
+    enum class BufferWipe : unsigned char
+    {
+        OnDestruction, // the buffer, when destroyed (then again on release)
+        OnRelease      // only this resource, when the block is returned
+    };
+
+    explicit SecureWipingResource(
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource(),
+        BufferWipe buffer_wipe = BufferWipe::OnDestruction) noexcept;
+
+    std::pmr::memory_resource *upstream_resource() const noexcept;
+    BufferWipe buffer_wipe() const noexcept;
+
+    // Whether SecureBuffers allocated from `mr` may skip their own wipe on
+    // destruction: `mr` is a `BufferWipe::OnRelease` wiping resource, or a
+    // monotonic arena directly on top of one. Pool resources never qualify,
+    // since they hand freed blocks to the next allocation unwiped.
+    static bool wipes_buffers(const std::pmr::memory_resource *mr) noexcept;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    std::pmr::memory_resource *upstream;
+    const BufferWipe wipe_mode;
+};
+
+#endif // SECUREWIPINGRESOURCE_HPP
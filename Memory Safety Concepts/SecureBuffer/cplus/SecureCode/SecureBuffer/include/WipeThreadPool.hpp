@@ -0,0 +1,74 @@
+#ifndef WIPETHREADPOOL_HPP
+#define WIPETHREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of threads that wipe one large range together.
+//
+// `wipe(ptr, len)` splits the range into page-aligned chunks, lets the pool
+// threads and the caller claim chunks from a shared counter, and returns
+// only once every chunk is zero. Chunks go through the `securewipe` kernels,
+// or `nontemporal::zero` when the whole range is above the streaming
+// threshold, so the stores carry the same
+// "never optimized away" guarantee as a single-threaded wipe, and joining on
+// completion makes them visible to the caller. One wipe runs at a time;
+// concurrent callers queue up.
+class WipeThreadPool
+{
+public:
+    // Ranges shorter than this are wiped by the caller alone.
+    static constexpr size_t MinParallelBytes = 4 * 1024 * 1024;
+
+    // @param threads Number of pool threads; the caller helps as well, so
+    //                `threads + 1` chunks are wiped at a time. 0 makes
+    //                `wipe` single-threaded.
+    explicit WipeThreadPool(size_t threads);
+    ~WipeThreadPool();
+
+    WipeThreadPool(const WipeThreadPool &) = delete;
+    WipeThreadPool &operator=(const WipeThreadPool &) = delete;
+
+    // Process-wide pool used by `SecureBuffer::parallel_wipe()` by default,
+    // with one thread per hardware thread besides the caller. Created on
+    // first use and never destroyed.
+    static WipeThreadPool &instance();
+
+    // Zeroes [ptr, ptr + len) and returns when all of it is done.
+    void wipe(void *ptr, size_t len) noexcept;
+
+    size_t thread_count() const noexcept;
+
+private:
+    void run() noexcept;
+    void stop() noexcept;
+    void work() noexcept;
+
+    std::vector<std::thread> threads;
+    std::mutex submit_lock; // one wipe at a time
+
+    // Current job, published under `lock` and bumped `generation`. Its
+    // fields are only rewritten once no pool thread is inside `work()`
+    // (`active == 0`), so a late thread never mixes two jobs.
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    uint64_t generation = 0;
+    size_t active = 0;
+    bool stopping = false;
+    char *base = nullptr; // page-aligned start of chunk 0
+    char *begin = nullptr;
+    char *end = nullptr;
+    size_t chunk = 0;
+    size_t chunks = 0;
+    bool streaming = false; // decided on the whole range, not per chunk
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+};
+
+#endif // WIPETHREADPOOL_HPP
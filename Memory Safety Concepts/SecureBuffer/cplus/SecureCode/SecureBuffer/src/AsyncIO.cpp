@@ -0,0 +1,449 @@
+#include "include/AsyncIO.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && !defined(SECUREBUFFER_NO_IO_URING)
+#define ASYNCIO_HAVE_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#ifdef ASYNCIO_HAVE_URING
+namespace
+{
+    int io_uring_setup(unsigned entries, io_uring_params *params) noexcept
+    {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args) noexcept
+    {
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+    }
+
+    // The kernel and this process share the ring indices; every access goes
+    // through an atomic view with the ordering the io_uring ABI requires.
+    unsigned load_acquire(unsigned *p) noexcept
+    {
+        return std::atomic_ref<unsigned>(*p).load(std::memory_order_acquire);
+    }
+
+    void store_release(unsigned *p, unsigned v) noexcept
+    {
+        std::atomic_ref<unsigned>(*p).store(v, std::memory_order_release);
+    }
+}
+
+// The mapped submission queue, completion queue and SQE array of one ring.
+struct AsyncIO::Ring
+{
+    int fd = -1;
+    void *sq_map = MAP_FAILED;
+    void *cq_map = MAP_FAILED;
+    size_t sq_map_len = 0;
+    size_t cq_map_len = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqes_len = 0;
+
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    io_uring_cqe *cqes;
+    bool buffers_registered = false;
+
+    // Creates and maps a ring of at least `entries` submissions.
+    // @return False if io_uring is unavailable; nothing is left open.
+    bool open(unsigned entries) noexcept
+    {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        fd = io_uring_setup(entries, &p);
+        if (fd < 0)
+            return false;
+
+        sq_map_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_map_len = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single)
+            sq_map_len = cq_map_len = std::max(sq_map_len, cq_map_len);
+
+        sq_map = mmap(nullptr, sq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq_map == MAP_FAILED)
+            return close(), false;
+        cq_map = single ? sq_map
+                        : mmap(nullptr, cq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_map == MAP_FAILED)
+            return close(), false;
+        sqes_len = p.sq_entries * sizeof(io_uring_sqe);
+        void *s = mmap(nullptr, sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (s == MAP_FAILED)
+            return close(), false;
+        sqes = static_cast<io_uring_sqe *>(s);
+
+        char *sq = static_cast<char *>(sq_map);
+        sq_head = reinterpret_cast<unsigned *>(sq + p.sq_off.head);
+        sq_tail = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+        sq_mask = reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+        char *cq = static_cast<char *>(cq_map);
+        cq_head = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    void close() noexcept
+    {
+        if (sqes != MAP_FAILED)
+            munmap(sqes, sqes_len);
+        if (cq_map != MAP_FAILED && cq_map != sq_map)
+            munmap(cq_map, cq_map_len);
+        if (sq_map != MAP_FAILED)
+            munmap(sq_map, sq_map_len);
+        if (fd >= 0)
+            ::close(fd);
+        sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+        sq_map = cq_map = MAP_FAILED;
+        fd = -1;
+    }
+
+    ~Ring() { close(); }
+};
+#else
+struct AsyncIO::Ring
+{
+    bool buffers_registered = false;
+    bool open(unsigned) noexcept { return false; }
+};
+#endif
+
+// Fallback backend: workers run queued operations with blocking syscalls
+// and hand the slots back for `wait()` to finish.
+struct AsyncIO::Workers
+{
+    std::mutex lock;
+    std::condition_variable job_ready;
+    std::condition_variable done_ready;
+    std::deque<unsigned> jobs;
+    std::vector<unsigned> done;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    Workers(std::vector<Op> &ops, unsigned count)
+    {
+        for (unsigned i = 0; i < std::max(count, 1u); ++i)
+            threads.emplace_back([this, &ops] { run(ops); });
+    }
+
+    ~Workers()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        job_ready.notify_all();
+        for (std::thread &t : threads)
+            t.join();
+    }
+
+    void run(std::vector<Op> &ops)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;) {
+            job_ready.wait(guard, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty())
+                return;
+            const unsigned slot = jobs.front();
+            jobs.pop_front();
+            guard.unlock();
+            Op &op = ops[slot];
+            op.result = transfer(op);
+            guard.lock();
+            done.push_back(slot);
+            done_ready.notify_one();
+        }
+    }
+
+    static ssize_t transfer(const Op &op) noexcept
+    {
+        ssize_t n;
+        do {
+            if (op.offset == CurrentPosition) {
+                n = op.writing ? ::write(op.fd, op.iov.iov_base, op.iov.iov_len)
+                               : ::read(op.fd, op.iov.iov_base, op.iov.iov_len);
+            } else {
+                const off_t off = static_cast<off_t>(op.offset);
+                n = op.writing ? ::pwrite(op.fd, op.iov.iov_base, op.iov.iov_len, off)
+                               : ::pread(op.fd, op.iov.iov_base, op.iov.iov_len, off);
+            }
+        } while (n < 0 && errno == EINTR);
+        return n < 0 ? -errno : n;
+    }
+};
+
+AsyncIO::AsyncIO(unsigned queue_depth, Backend preferred, unsigned threads)
+    : ops(std::max(queue_depth, 1u))
+{
+    free_slots.reserve(ops.size());
+    for (unsigned i = static_cast<unsigned>(ops.size()); i-- > 0;)
+        free_slots.push_back(i);
+    queued.reserve(ops.size());
+
+    auto r = std::make_unique<Ring>();
+    if (preferred == Backend::IoUring && r->open(static_cast<unsigned>(ops.size()))) {
+        ring = std::move(r);
+    } else {
+        workers = std::make_unique<Workers>(ops, threads);
+    }
+}
+
+AsyncIO::~AsyncIO()
+{
+    try {
+        drain();
+    } catch (...) {
+        // Nothing more can be submitted; what is in flight finishes once
+        // the ring is closed.
+    }
+    unregister_buffers();
+}
+
+bool AsyncIO::io_uring_supported() noexcept
+{
+    static const bool supported = [] {
+        Ring probe;
+        return probe.open(2);
+    }();
+    return supported;
+}
+
+AsyncIO::Backend AsyncIO::backend() const noexcept
+{
+    return ring ? Backend::IoUring : Backend::Threads;
+}
+
+const char *AsyncIO::backend_name(Backend backend) noexcept
+{
+    return backend == Backend::IoUring ? "io_uring" : "threads";
+}
+
+bool AsyncIO::register_buffers(std::span<SecureBuffer> bufs)
+{
+    unregister_buffers();
+#ifdef ASYNCIO_HAVE_URING
+    if (!ring)
+        return false;
+    std::vector<iovec> iov;
+    iov.reserve(bufs.size());
+    for (SecureBuffer &b : bufs) {
+        // Pages that a wipe may discard would detach from the pinned copy.
+        if (b.capacity() > 0 && b.storage() != SecureBuffer::Storage::Secret && !b.discards_pages())
+            iov.push_back(iovec{b.data_ptr(), b.capacity()});
+    }
+    if (iov.empty())
+        return false;
+    // The kernel waits for the ring to go idle before swapping the table.
+    drain();
+    if (io_uring_register(ring->fd, IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(iov.size())) != 0)
+        return false;
+    ring->buffers_registered = true;
+    for (size_t i = 0; i < iov.size(); ++i)
+        fixed.emplace(static_cast<const char *>(iov[i].iov_base), static_cast<int>(i));
+    return true;
+#else
+    (void)bufs;
+    return false;
+#endif
+}
+
+void AsyncIO::unregister_buffers() noexcept
+{
+    fixed.clear();
+#ifdef ASYNCIO_HAVE_URING
+    if (ring && ring->buffers_registered) {
+        try {
+            drain();
+        } catch (...) {
+        }
+        io_uring_register(ring->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        ring->buffers_registered = false;
+    }
+#endif
+}
+
+// Claims a slot and queues the operation in it. When every slot is taken it
+// waits for half of them, not one: freeing a single slot at a time would
+// turn a long batch into one submission per operation.
+void AsyncIO::enqueue(int fd, bool writing, char *data, size_t len, uint64_t offset, Callback done)
+{
+    while (free_slots.empty())
+        wait(std::max<size_t>(ops.size() / 2, 1));
+    const unsigned slot = free_slots.back();
+    free_slots.pop_back();
+    int fixed_index = -1;
+    if (!fixed.empty()) {
+        auto it = fixed.find(data);
+        if (it != fixed.end())
+            fixed_index = it->second;
+    }
+    ops[slot] = Op{fd, writing, fixed_index, offset, iovec{data, len}, std::move(done), 0};
+    queued.push_back(slot);
+}
+
+void AsyncIO::read(int fd, SecureBuffer &buf, uint64_t offset, Callback done)
+{
+    enqueue(fd, false, buf.data_ptr(), buf.size_bytes(), offset, std::move(done));
+}
+
+void AsyncIO::write(int fd, const SecureBuffer &buf, uint64_t offset, Callback done)
+{
+    enqueue(fd, true, const_cast<char *>(buf.data_ptr()), buf.size_bytes(), offset, std::move(done));
+}
+
+void AsyncIO::submit()
+{
+    if (queued.empty())
+        return;
+    if (workers) {
+        {
+            std::lock_guard<std::mutex> guard(workers->lock);
+            workers->jobs.insert(workers->jobs.end(), queued.begin(), queued.end());
+        }
+        workers->job_ready.notify_all();
+        in_flight += queued.size();
+        queued.clear();
+        return;
+    }
+#ifdef ASYNCIO_HAVE_URING
+    // One SQE per operation, published with a single tail store. The ring
+    // has at least as many entries as there are slots, so it never fills.
+    Ring &r = *ring;
+    const unsigned start = *r.sq_tail;
+    unsigned tail = start;
+    const unsigned mask = *r.sq_mask;
+    for (unsigned slot : queued) {
+        const Op &op = ops[slot];
+        const unsigned idx = tail & mask;
+        io_uring_sqe *sqe = &r.sqes[idx];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->fd = op.fd;
+        sqe->off = op.offset == CurrentPosition ? ~uint64_t(0) : op.offset;
+        sqe->user_data = slot;
+        if (op.fixed_index >= 0) {
+            sqe->opcode = op.writing ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe->addr = reinterpret_cast<uint64_t>(op.iov.iov_base);
+            sqe->len = static_cast<uint32_t>(op.iov.iov_len);
+            sqe->buf_index = static_cast<uint16_t>(op.fixed_index);
+        } else {
+            sqe->opcode = op.writing ? IORING_OP_WRITEV : IORING_OP_READV;
+            sqe->addr = reinterpret_cast<uint64_t>(&op.iov);
+            sqe->len = 1;
+        }
+        r.sq_array[idx] = idx;
+        ++tail;
+    }
+    store_release(r.sq_tail, tail);
+
+    unsigned left = static_cast<unsigned>(queued.size());
+    while (left > 0) {
+        const int n = io_uring_enter(r.fd, left, 0, 0);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            const int err = errno;
+            // The kernel consumes SQEs in order and, without SQPOLL, only
+            // inside io_uring_enter: what it took is in flight, the rest is
+            // unpublished again and stays queued for the next submit().
+            const unsigned head = load_acquire(r.sq_head);
+            const size_t taken = head - start;
+            store_release(r.sq_tail, head);
+            in_flight += taken;
+            queued.erase(queued.begin(), queued.begin() + static_cast<std::ptrdiff_t>(taken));
+            throw std::system_error(err, std::generic_category(), "io_uring_enter");
+        }
+        left -= static_cast<unsigned>(n);
+    }
+    in_flight += queued.size();
+    queued.clear();
+#endif
+}
+
+// Frees the slot of a finished operation and runs its callback. The slot is
+// released first so the callback may queue follow-up operations.
+void AsyncIO::complete(unsigned slot) noexcept
+{
+    Callback done = std::move(ops[slot].done);
+    const ssize_t result = ops[slot].result;
+    free_slots.push_back(slot);
+    --in_flight;
+    if (done)
+        done(result);
+}
+
+// Collects at least `min_completions` finished operations and runs their
+// callbacks.
+size_t AsyncIO::reap(size_t min_completions)
+{
+    std::vector<unsigned> finished;
+    if (workers) {
+        std::unique_lock<std::mutex> guard(workers->lock);
+        workers->done_ready.wait(guard, [&] { return workers->done.size() >= min_completions; });
+        finished.swap(workers->done);
+    }
+#ifdef ASYNCIO_HAVE_URING
+    else {
+        Ring &r = *ring;
+        for (;;) {
+            unsigned head = *r.cq_head;
+            const unsigned tail = load_acquire(r.cq_tail);
+            for (; head != tail; ++head) {
+                const io_uring_cqe &cqe = r.cqes[head & *r.cq_mask];
+                const unsigned slot = static_cast<unsigned>(cqe.user_data);
+                ops[slot].result = cqe.res;
+                finished.push_back(slot);
+            }
+            store_release(r.cq_head, head);
+            if (finished.size() >= min_completions)
+                break;
+            const unsigned want = static_cast<unsigned>(min_completions - finished.size());
+            if (io_uring_enter(r.fd, 0, want, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+        }
+    }
+#endif
+    for (unsigned slot : finished)
+        complete(slot);
+    return finished.size();
+}
+
+size_t AsyncIO::wait(size_t min_completions)
+{
+    submit();
+    return reap(std::min(min_completions, in_flight));
+}
+
+void AsyncIO::drain()
+{
+    while (pending() > 0)
+        wait(in_flight + queued.size());
+}
+
+size_t AsyncIO::pending() const noexcept
+{
+    return in_flight + queued.size();
+}
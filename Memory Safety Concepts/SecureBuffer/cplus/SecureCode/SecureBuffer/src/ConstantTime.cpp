@@ -0,0 +1,210 @@
+#include "include/ConstantTime.hpp"
+#include <atomic>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CONSTTIME_X86 1
+#include <immintrin.h>
+#endif
+
+namespace consttime
+{
+namespace
+{
+    using EqualFn = bool (*)(const unsigned char *, const unsigned char *, size_t) noexcept;
+
+    // Hides the accumulator's value from the optimizer, so it cannot turn
+    // the reduction back into an early-exit comparison.
+    template <typename T>
+    inline T opaque(T v) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __asm__("" : "+r"(v));
+#endif
+        return v;
+    }
+
+    // Turns an accumulated difference into a bool without branching on it.
+    inline bool is_zero(uint64_t diff) noexcept
+    {
+        diff = opaque(diff);
+        return static_cast<bool>(1 & ((diff - 1) >> 63) & ~(diff >> 63));
+    }
+
+    uint64_t diff_scalar(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        uint64_t diff = 0;
+        for (size_t i = 0; i < len; ++i){
+            diff |= opaque<uint64_t>(a[i] ^ b[i]);
+        }
+        return diff;
+    }
+
+    bool equal_scalar(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        return is_zero(diff_scalar(a, b, len));
+    }
+
+#ifdef CONSTTIME_X86
+    // Vector kernels OR the XOR of both inputs into four independent
+    // accumulators (so the OR chain does not limit throughput) and reduce
+    // them once at the end. Inputs may be unaligned; the sub-vector tail goes
+    // through the scalar loop.
+
+    __attribute__((target("sse2"))) inline __m128i diff16(const unsigned char *a, const unsigned char *b, size_t off) noexcept
+    {
+        return _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + off)),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + off)));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i diff32(const unsigned char *a, const unsigned char *b, size_t off) noexcept
+    {
+        return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + off)),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + off)));
+    }
+
+    // One bit per non-zero byte of `v`. Uses only SSE2 (no 64-bit lane
+    // extraction), so it also builds for 32-bit x86.
+    __attribute__((target("sse2"))) inline uint64_t nonzero_bytes(__m128i v) noexcept
+    {
+        return static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) ^ 0xFFFF);
+    }
+
+    __attribute__((target("sse2"))) bool equal_sse2(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        constexpr size_t W = 16;
+        __m128i acc0 = _mm_setzero_si128(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        size_t i = 0;
+        for (; i + 4 * W <= len; i += 4 * W){
+            acc0 = _mm_or_si128(acc0, diff16(a, b, i));
+            acc1 = _mm_or_si128(acc1, diff16(a, b, i + W));
+            acc2 = _mm_or_si128(acc2, diff16(a, b, i + 2 * W));
+            acc3 = _mm_or_si128(acc3, diff16(a, b, i + 3 * W));
+        }
+        __m128i acc = _mm_or_si128(_mm_or_si128(acc0, acc1), _mm_or_si128(acc2, acc3));
+        for (; i + W <= len; i += W){
+            acc = _mm_or_si128(acc, diff16(a, b, i));
+        }
+        const uint64_t lanes = nonzero_bytes(acc);
+        return is_zero(lanes | diff_scalar(a + i, b + i, len - i));
+    }
+
+    __attribute__((target("avx2"))) bool equal_avx2(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        constexpr size_t W = 32;
+        __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        size_t i = 0;
+        for (; i + 4 * W <= len; i += 4 * W){
+            acc0 = _mm256_or_si256(acc0, diff32(a, b, i));
+            acc1 = _mm256_or_si256(acc1, diff32(a, b, i + W));
+            acc2 = _mm256_or_si256(acc2, diff32(a, b, i + 2 * W));
+            acc3 = _mm256_or_si256(acc3, diff32(a, b, i + 3 * W));
+        }
+        __m256i acc = _mm256_or_si256(_mm256_or_si256(acc0, acc1), _mm256_or_si256(acc2, acc3));
+        for (; i + W <= len; i += W){
+            acc = _mm256_or_si256(acc, diff32(a, b, i));
+        }
+        const __m128i folded = _mm_or_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        const uint64_t lanes = nonzero_bytes(folded);
+        return is_zero(lanes | diff_scalar(a + i, b + i, len - i));
+    }
+#endif // CONSTTIME_X86
+
+    EqualFn kernel_fn(Kernel k) noexcept
+    {
+        switch (k){
+#ifdef CONSTTIME_X86
+        case Kernel::SSE2:
+            return equal_sse2;
+        case Kernel::AVX2:
+            return equal_avx2;
+#endif
+        default:
+            return equal_scalar;
+        }
+    }
+
+    Kernel select_kernel() noexcept
+    {
+        if (is_supported(Kernel::AVX2))
+            return Kernel::AVX2;
+        if (is_supported(Kernel::SSE2))
+            return Kernel::SSE2;
+        return Kernel::Scalar;
+    }
+
+    bool equal_resolve(const unsigned char *a, const unsigned char *b, size_t len) noexcept;
+
+    // Same lazy dispatch as `securewipe`: starts at the resolver, which
+    // caches the chosen kernel on first use.
+    std::atomic<EqualFn> active_fn{equal_resolve};
+    std::atomic<Kernel> bound_kernel{Kernel::Scalar};
+
+    // Picks the kernel, records it for `active_kernel()` and binds it.
+    EqualFn bind_kernel() noexcept
+    {
+        const Kernel k = select_kernel();
+        bound_kernel.store(k, std::memory_order_relaxed);
+        EqualFn fn = kernel_fn(k);
+        active_fn.store(fn, std::memory_order_release);
+        return fn;
+    }
+
+    bool equal_resolve(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        return bind_kernel()(a, b, len);
+    }
+}
+
+bool equal(const void *a, const void *b, size_t len) noexcept
+{
+    return active_fn.load(std::memory_order_relaxed)(static_cast<const unsigned char *>(a),
+                                                     static_cast<const unsigned char *>(b), len);
+}
+
+bool equal_with(Kernel k, const void *a, const void *b, size_t len) noexcept
+{
+    return kernel_fn(is_supported(k) ? k : Kernel::Scalar)(static_cast<const unsigned char *>(a),
+                                                           static_cast<const unsigned char *>(b), len);
+}
+
+bool is_supported(Kernel k) noexcept
+{
+    switch (k){
+    case Kernel::Scalar:
+        return true;
+#ifdef CONSTTIME_X86
+    case Kernel::SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+    case Kernel::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+// Reports the kernel `equal` is bound to, binding it first if nothing has
+// been compared yet.
+Kernel active_kernel() noexcept
+{
+    if (active_fn.load(std::memory_order_acquire) == equal_resolve)
+        bind_kernel();
+    return bound_kernel.load(std::memory_order_relaxed);
+}
+
+const char *kernel_name(Kernel k) noexcept
+{
+    switch (k){
+    case Kernel::Scalar:
+        return "scalar";
+    case Kernel::SSE2:
+        return "sse2";
+    case Kernel::AVX2:
+        return "avx2";
+    }
+    return "unknown";
+}
+}
@@ -0,0 +1,137 @@
+#include "include/DeferredWiper.hpp"
+#include <optional>
+#include <pthread.h>
+#include <thread>
+
+namespace
+{
+    // Set on the wiper thread so the buffers it destroys are wiped there
+    // instead of being queued again.
+    thread_local bool on_wiper_thread = false;
+}
+
+// Holds `start_lock` across fork() like ForkRepopulator does for its
+// registry, and resets the child, which inherits the queue and threshold but
+// not the wiper thread.
+DeferredWiper::DeferredWiper()
+{
+    pthread_atfork([] { instance().start_lock.lock(); },
+                   [] { instance().start_lock.unlock(); },
+                   [] { instance().reset_in_child(); });
+}
+
+DeferredWiper &DeferredWiper::instance()
+{
+    static DeferredWiper *wiper = new DeferredWiper();
+    return *wiper;
+}
+
+void DeferredWiper::enable(size_t threshold_bytes, size_t queue_capacity)
+{
+    std::lock_guard<std::mutex> guard(start_lock);
+    if (!queue){
+        queue = std::make_unique<SecureQueue<SecureBuffer>>(queue_capacity);
+        std::thread([this] { run(); }).detach();
+    }
+    // Release: a destructor that sees the new threshold also sees the queue.
+    threshold.store(threshold_bytes, std::memory_order_release);
+}
+
+// Sequentially consistent with the `pending` increment in `try_defer`: a
+// destroyer either sees `Disabled` or is already counted when `flush` looks.
+void DeferredWiper::disable() noexcept
+{
+    threshold.store(Disabled, std::memory_order_seq_cst);
+    flush();
+}
+
+void DeferredWiper::flush() noexcept
+{
+    size_t n;
+    while ((n = pending.load(std::memory_order_seq_cst)) != 0){
+        pending.wait(n, std::memory_order_acquire);
+    }
+}
+
+bool DeferredWiper::enabled() const noexcept
+{
+    return threshold.load(std::memory_order_relaxed) != Disabled;
+}
+
+DeferredWiper::Stats DeferredWiper::stats() const noexcept
+{
+    return Stats{deferred.load(std::memory_order_relaxed), fallbacks.load(std::memory_order_relaxed)};
+}
+
+// Inline buffers have nothing to hand off. Resource buffers stay on the
+// caller's thread: their memory belongs to a caller-supplied resource that
+// may be released or destroyed right after the buffer, and that is usually
+// not thread-safe (e.g. `monotonic_buffer_resource`).
+//
+// The buffer is counted in `pending` before the threshold is trusted, so a
+// concurrent `disable()`/`flush()` cannot return while it is still being
+// pushed; the relaxed pre-check only keeps small buffers off that counter.
+bool DeferredWiper::try_defer(SecureBuffer &buf) noexcept
+{
+    if (buf.size_bytes() < threshold.load(std::memory_order_relaxed) || on_wiper_thread
+        || buf.storage() == SecureBuffer::Storage::Inline || buf.storage() == SecureBuffer::Storage::Resource)
+        return false;
+
+    pending.fetch_add(1, std::memory_order_seq_cst);
+    if (buf.size_bytes() < threshold.load(std::memory_order_seq_cst)){
+        // Disabled (or raised) in the meantime: wipe on this thread.
+        unpend();
+        return false;
+    }
+    if (!queue->try_push(std::move(buf))){
+        // Queue full: the caller wipes synchronously.
+        unpend();
+        fallbacks.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    deferred.fetch_add(1, std::memory_order_relaxed);
+    ready.release();
+    return true;
+}
+
+// Wiper thread: destroys queued buffers (wipe + release) one at a time and
+// wakes `flush()` callers once nothing is pending.
+void DeferredWiper::run() noexcept
+{
+    on_wiper_thread = true;
+    for (;;){
+        ready.acquire();
+        // Every `release()` follows a completed push, but with several
+        // producers an earlier cell may still be mid-push, so retry briefly.
+        std::optional<SecureBuffer> buf;
+        while (!(buf = queue->try_pop()))
+            std::this_thread::yield();
+        buf.reset();
+        unpend();
+    }
+}
+
+// Runs in a fork()ed child, which has no wiper thread: buffers it destroys
+// would sit in the queue unwiped and `flush()` would never return. Wipes the
+// child's copies of whatever the parent had queued, goes back to synchronous
+// wiping, and lets a later `enable()` start a thread of the child's own.
+void DeferredWiper::reset_in_child() noexcept
+{
+    threshold.store(Disabled, std::memory_order_relaxed);
+    if (queue){
+        while (queue->try_pop()){
+        }
+        queue.reset();
+    }
+    while (ready.try_acquire()){
+    }
+    pending.store(0, std::memory_order_relaxed);
+    start_lock.unlock();
+}
+
+// Drops one buffer from `pending`, waking `flush()` callers at zero.
+void DeferredWiper::unpend() noexcept
+{
+    if (pending.fetch_sub(1, std::memory_order_release) == 1)
+        pending.notify_all();
+}
@@ -0,0 +1,69 @@
+#include "include/ForkRepopulator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <pthread.h>
+#include <utility>
+
+namespace
+{
+    std::atomic<uint64_t> generation{0};
+}
+
+// Holds the registry lock across fork() so the child never inherits it
+// locked by a thread that does not exist there.
+ForkRepopulator::ForkRepopulator()
+{
+    pthread_atfork([] { instance().lock.lock(); },
+                   [] { instance().lock.unlock(); },
+                   [] {
+                       instance().lock.unlock();
+                       generation.fetch_add(1, std::memory_order_relaxed);
+                   });
+}
+
+ForkRepopulator &ForkRepopulator::instance()
+{
+    static ForkRepopulator *registry = new ForkRepopulator();
+    return *registry;
+}
+
+void ForkRepopulator::add(SecureBuffer &buf, Loader loader)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry &e) { return e.buf == &buf; });
+    if (it != entries.end()) {
+        it->loader = std::move(loader);
+    } else {
+        entries.push_back(Entry{&buf, std::move(loader)});
+    }
+}
+
+void ForkRepopulator::forget(const SecureBuffer &buf) noexcept
+{
+    std::lock_guard<std::mutex> guard(lock);
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const Entry &e) { return e.buf == &buf; }),
+                  entries.end());
+}
+
+// The loaders run under the lock, so they must not call back into the
+// registry.
+size_t ForkRepopulator::repopulate()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (Entry &e : entries) {
+        e.loader(*e.buf);
+    }
+    return entries.size();
+}
+
+size_t ForkRepopulator::size() const noexcept
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
+
+uint64_t ForkRepopulator::fork_generation() noexcept
+{
+    instance(); // installs the atfork handlers
+    return generation.load(std::memory_order_relaxed);
+}
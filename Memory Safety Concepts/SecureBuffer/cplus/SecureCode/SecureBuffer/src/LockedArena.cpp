@@ -0,0 +1,296 @@
+#include "include/LockedArena.hpp"
+#include "include/PageAllocator.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_memfd_secret
+#define SYS_memfd_secret 447
+#endif
+
+namespace
+{
+    // Soft RLIMIT_MEMLOCK, or 0 if it cannot be read.
+    size_t memlock_limit() noexcept
+    {
+        struct rlimit rl;
+        if (getrlimit(RLIMIT_MEMLOCK, &rl) != 0)
+            return 0;
+        if (rl.rlim_cur == RLIM_INFINITY)
+            return SIZE_MAX;
+        return static_cast<size_t>(rl.rlim_cur);
+    }
+
+    // A zeroed `memfd_secret` mapping of `length` bytes, or nullptr. The fd
+    // is closed once mapped; the mapping keeps the memory alive.
+    char *map_secret(size_t length) noexcept
+    {
+        const int fd = static_cast<int>(syscall(SYS_memfd_secret, O_CLOEXEC));
+        if (fd < 0)
+            return nullptr;
+        void *mem = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(length)) == 0)
+            mem = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        close(fd);
+        errno = err;
+        return mem == MAP_FAILED ? nullptr : static_cast<char *>(mem);
+    }
+}
+
+LockedArena::Budget::Budget(size_t limit_bytes) noexcept
+    : limit_bytes(limit_bytes)
+{
+}
+
+size_t LockedArena::Budget::reserve(size_t min_bytes, size_t max_bytes, size_t unit) noexcept
+{
+    size_t used = used_bytes.load(std::memory_order_relaxed);
+    for (;;){
+        const size_t remaining = limit_bytes > used ? limit_bytes - used : 0;
+        const size_t take = (remaining < max_bytes ? remaining : max_bytes) / unit * unit;
+        if (take == 0 || take < min_bytes)
+            return 0;
+        if (used_bytes.compare_exchange_weak(used, used + take, std::memory_order_relaxed))
+            return take;
+    }
+}
+
+void LockedArena::Budget::give_back(size_t bytes) noexcept
+{
+    used_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+size_t LockedArena::Budget::limit() const noexcept
+{
+    return limit_bytes;
+}
+
+size_t LockedArena::Budget::used() const noexcept
+{
+    return used_bytes.load(std::memory_order_relaxed);
+}
+
+LockedArena::LockedArena(size_t budget_bytes, Source source)
+    : own_budget(budget_bytes), budget(own_budget), region_source(source)
+{
+}
+
+LockedArena::LockedArena(Budget &shared, Source source)
+    : own_budget(0), budget(shared), region_source(source)
+{
+}
+
+// Unlocks and unmaps every region and returns their bytes to the budget.
+// Outstanding blocks become dangling, so only arenas whose buffers are all
+// gone may be destroyed.
+LockedArena::~LockedArena()
+{
+    for (const Region &r : regions){
+        if (region_source != Source::Secret)
+            munlock(r.base, r.length);
+        munmap(r.base, r.length);
+    }
+    budget.give_back(locked_bytes);
+}
+
+LockedArena::Budget &LockedArena::shared_budget()
+{
+    static Budget *budget = new Budget(memlock_limit());
+    return *budget;
+}
+
+LockedArena &LockedArena::instance()
+{
+    static LockedArena *arena = new LockedArena(shared_budget());
+    return *arena;
+}
+
+LockedArena &LockedArena::secret_instance()
+{
+    static LockedArena *arena = new LockedArena(shared_budget(), Source::Secret);
+    return *arena;
+}
+
+LockedArena &LockedArena::fork_instance()
+{
+    static LockedArena *arena = new LockedArena(shared_budget(), Source::WipeOnFork);
+    return *arena;
+}
+
+// Probes with a throwaway fd: ENOSYS on older kernels, and also refused when
+// secretmem is disabled on the kernel command line.
+bool LockedArena::secret_supported() noexcept
+{
+    static const bool supported = [] {
+        const long fd = syscall(SYS_memfd_secret, O_CLOEXEC);
+        if (fd < 0)
+            return false;
+        close(static_cast<int>(fd));
+        return true;
+    }();
+    return supported;
+}
+
+bool LockedArena::fits(size_t n) noexcept
+{
+    return n > 0 && n <= MaxBlock;
+}
+
+size_t LockedArena::block_size(size_t n) noexcept
+{
+    return MinBlock << class_index(n);
+}
+
+size_t LockedArena::class_index(size_t n) noexcept
+{
+    size_t idx = 0;
+    size_t block = MinBlock;
+    while (block < n){
+        block <<= 1;
+        ++idx;
+    }
+    return idx;
+}
+
+// Maps a new region of at least `min_bytes` with `map_pages`, sized
+// to whatever is left of the budget up to `RegionBytes`. The unused tail of
+// the previous region is split into blocks and kept on the free lists.
+// Called with `lock` held.
+bool LockedArena::map_region(size_t min_bytes) noexcept
+{
+    if (map_disabled)
+        return false;
+    if (retry_in > 0){
+        --retry_in;
+        return false;
+    }
+    const size_t length = budget.reserve(min_bytes, RegionBytes, pagealloc::page_size());
+    if (length == 0)
+        return false;
+
+    char *mem = map_pages(length);
+    if (!mem){
+        // EPERM, ENOSYS and EINVAL (locking not permitted, no kernel support)
+        // will not change, so stop issuing the syscalls. Anything else, e.g.
+        // ENOMEM/EAGAIN over RLIMIT_MEMLOCK, may pass once other locked
+        // memory is released: back off and retry.
+        const int err = errno;
+        budget.give_back(length);
+        if (err == EPERM || err == ENOSYS || err == EINVAL)
+            map_disabled = true;
+        else
+            retry_in = RetryInterval;
+        return false;
+    }
+    try {
+        regions.push_back(Region{mem, length});
+    } catch (...) {
+        if (region_source != Source::Secret)
+            munlock(mem, length);
+        munmap(mem, length);
+        budget.give_back(length);
+        return false;
+    }
+    locked_bytes += length;
+
+    for (size_t idx = NumClasses; idx-- > 0;){
+        const size_t block = MinBlock << idx;
+        while (static_cast<size_t>(bump_end - bump) >= block){
+            FreeBlock *b = reinterpret_cast<FreeBlock *>(bump);
+            b->next = free_lists[idx];
+            free_lists[idx] = b;
+            bump += block;
+        }
+    }
+    bump = mem;
+    bump_end = bump + length;
+    return true;
+}
+
+// Maps one zeroed region of `length` bytes from this arena's source, or
+// returns nullptr with errno set by the call that failed. Secret memory is
+// never swapped or dumped, so it needs no `mlock`/`MADV_DONTDUMP` of its own.
+char *LockedArena::map_pages(size_t length) noexcept
+{
+    if (region_source == Source::Secret){
+        if (!secret_supported()){
+            errno = ENOSYS;
+            return nullptr;
+        }
+        return map_secret(length);
+    }
+
+    void *mem = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        return nullptr;
+    if (mlock(mem, length) != 0){
+        const int err = errno;
+        munmap(mem, length);
+        errno = err;
+        return nullptr;
+    }
+#ifdef MADV_DONTDUMP
+    madvise(mem, length, MADV_DONTDUMP);
+#endif
+    if (region_source == Source::WipeOnFork && !pagealloc::wipe_on_fork(static_cast<char *>(mem), length)){
+        const int err = errno;
+        munlock(mem, length);
+        munmap(mem, length);
+        errno = err;
+        return nullptr;
+    }
+    return static_cast<char *>(mem);
+}
+
+char *LockedArena::allocate(size_t n) noexcept
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!fits(n)){
+        ++fallbacks;
+        return nullptr;
+    }
+    const size_t idx = class_index(n);
+    const size_t block = MinBlock << idx;
+
+    char *p;
+    if (FreeBlock *b = free_lists[idx]){
+        free_lists[idx] = b->next;
+        b->next = nullptr; // rest of the block was wiped on release
+        p = reinterpret_cast<char *>(b);
+    } else {
+        if (static_cast<size_t>(bump_end - bump) < block && !map_region(block)){
+            ++fallbacks;
+            return nullptr;
+        }
+        p = bump; // fresh mmap pages are already zero
+        bump += block;
+    }
+    ++allocations;
+    return p;
+}
+
+void LockedArena::release(char *p, size_t n) noexcept
+{
+    if (!p)
+        return;
+    std::lock_guard<std::mutex> guard(lock);
+    const size_t idx = class_index(n);
+    FreeBlock *b = reinterpret_cast<FreeBlock *>(p);
+    b->next = free_lists[idx];
+    free_lists[idx] = b;
+}
+
+LockedArena::Stats LockedArena::stats() const noexcept
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return Stats{budget.limit(), locked_bytes, regions.size(), allocations, fallbacks};
+}
+
+LockedArena::Source LockedArena::source() const noexcept
+{
+    return region_source;
+}
@@ -0,0 +1,184 @@
+#include "include/NonTemporal.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NONTEMPORAL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace nontemporal
+{
+namespace
+{
+    constexpr size_t Line = 64;
+    constexpr size_t FallbackCacheBytes = 8 * 1024 * 1024;
+
+    inline void escape(void *ptr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
+        (void)ptr;
+#endif
+    }
+
+    // Last-level cache size: sysconf where glibc reports it, otherwise the
+    // largest cache listed in sysfs, otherwise a conservative 8 MiB.
+    size_t last_level_cache_bytes() noexcept
+    {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+        if (long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE); l3 > 0)
+            return static_cast<size_t>(l3);
+#endif
+        size_t largest = 0;
+        for (int index = 0; index < 8; ++index){
+            std::ifstream in("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+            size_t value = 0;
+            std::string unit;
+            if (!(in >> value))
+                break;
+            in >> unit;
+            value *= unit == "K" ? 1024 : unit == "M" ? 1024 * 1024 : 1;
+            largest = value > largest ? value : largest;
+        }
+        return largest ? largest : FallbackCacheBytes;
+    }
+
+    std::atomic<size_t> override_threshold{0};
+
+    // Unaligned head and tail pieces use ordinary stores; only whole,
+    // aligned cache lines are streamed.
+    void zero_lines(char *p, size_t len) noexcept;
+    void copy_lines(char *dst, const char *src, size_t len) noexcept;
+
+#ifdef NONTEMPORAL_X86
+    __attribute__((target("avx2"))) void zero_lines_avx2(char *p, size_t len) noexcept
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        for (char *end = p + len; p < end; p += Line){
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(p), zero);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(p + 32), zero);
+        }
+    }
+
+    __attribute__((target("sse2"))) void zero_lines_sse2(char *p, size_t len) noexcept
+    {
+        const __m128i zero = _mm_setzero_si128();
+        for (char *end = p + len; p < end; p += Line){
+            _mm_stream_si128(reinterpret_cast<__m128i *>(p), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(p + 16), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(p + 32), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(p + 48), zero);
+        }
+    }
+
+    __attribute__((target("avx2"))) void copy_lines_avx2(char *dst, const char *src, size_t len) noexcept
+    {
+        for (size_t i = 0; i < len; i += Line){
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 32));
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), a);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i + 32), b);
+        }
+    }
+
+    __attribute__((target("sse2"))) void copy_lines_sse2(char *dst, const char *src, size_t len) noexcept
+    {
+        for (size_t i = 0; i < len; i += Line){
+            for (size_t k = 0; k < Line; k += 16){
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + k),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + k)));
+            }
+        }
+    }
+
+    bool has_avx2() noexcept
+    {
+        static const bool avx2 = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        }();
+        return avx2;
+    }
+
+    void zero_lines(char *p, size_t len) noexcept
+    {
+        if (has_avx2())
+            zero_lines_avx2(p, len);
+        else
+            zero_lines_sse2(p, len);
+        _mm_sfence();
+    }
+
+    void copy_lines(char *dst, const char *src, size_t len) noexcept
+    {
+        if (has_avx2())
+            copy_lines_avx2(dst, src, len);
+        else
+            copy_lines_sse2(dst, src, len);
+        _mm_sfence();
+    }
+#else
+    void zero_lines(char *p, size_t len) noexcept
+    {
+        std::memset(p, 0, len);
+    }
+
+    void copy_lines(char *dst, const char *src, size_t len) noexcept
+    {
+        std::memcpy(dst, src, len);
+    }
+#endif
+
+    // Bytes from `p` to the next cache-line boundary (at most `len`).
+    size_t head_bytes(const char *p, size_t len) noexcept
+    {
+        const size_t head = (Line - reinterpret_cast<uintptr_t>(p) % Line) % Line;
+        return head < len ? head : len;
+    }
+}
+
+size_t threshold() noexcept
+{
+    if (size_t t = override_threshold.load(std::memory_order_relaxed))
+        return t;
+    static const size_t derived = last_level_cache_bytes() / 2;
+    return derived;
+}
+
+void set_threshold(size_t bytes) noexcept
+{
+    override_threshold.store(bytes, std::memory_order_relaxed);
+}
+
+void zero(void *ptr, size_t len) noexcept
+{
+    if (!ptr || len == 0)
+        return;
+    char *p = static_cast<char *>(ptr);
+    const size_t head = head_bytes(p, len);
+    const size_t body = (len - head) / Line * Line;
+    std::memset(p, 0, head);
+    zero_lines(p + head, body);
+    std::memset(p + head + body, 0, len - head - body);
+    escape(ptr);
+}
+
+void copy(void *dst, const void *src, size_t len) noexcept
+{
+    if (len == 0)
+        return;
+    char *d = static_cast<char *>(dst);
+    const char *s = static_cast<const char *>(src);
+    const size_t head = head_bytes(d, len);
+    const size_t body = (len - head) / Line * Line;
+    std::memcpy(d, s, head);
+    copy_lines(d + head, s + head, body);
+    std::memcpy(d + head + body, s + head + body, len - head - body);
+}
+}
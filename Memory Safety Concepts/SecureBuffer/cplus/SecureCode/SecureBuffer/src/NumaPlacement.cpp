@@ -0,0 +1,92 @@
+#include "include/NumaPlacement.hpp"
+#include "include/PageAllocator.hpp"
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace numa
+{
+namespace
+{
+    // Parses a sysfs node list such as "0-1,3" and returns the highest id + 1.
+    int parse_node_list(const std::string &list) noexcept
+    {
+        int highest = -1;
+        int value = -1;
+        for (char ch : list){
+            if (ch >= '0' && ch <= '9'){
+                value = (value < 0 ? 0 : value * 10) + (ch - '0');
+            } else {
+                if (value > highest)
+                    highest = value;
+                value = -1;
+            }
+        }
+        if (value > highest)
+            highest = value;
+        return highest + 1;
+    }
+}
+
+int node_count() noexcept
+{
+    static const int count = [] {
+        std::ifstream in("/sys/devices/system/node/online");
+        std::string list;
+        const int n = std::getline(in, list) ? parse_node_list(list) : 0;
+        return n > 0 ? (n < MaxNodes ? n : MaxNodes) : 1;
+    }();
+    return count;
+}
+
+int current_node() noexcept
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < unsigned(MaxNodes))
+        return static_cast<int>(node);
+#endif
+    return 0;
+}
+
+bool bind(void *p, size_t len, int node) noexcept
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    if (node < 0 || node >= MaxNodes)
+        return false;
+    unsigned long mask = 1ul << node;
+    // maxnode counts one past the last bit the kernel should read.
+    return syscall(SYS_mbind, p, len, MPOL_PREFERRED, &mask, MaxNodes + 1, MPOL_MF_MOVE) == 0;
+#else
+    (void)p;
+    (void)len;
+    return node == 0;
+#endif
+}
+
+int node_of(const void *p) noexcept
+{
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, p, MPOL_F_NODE | MPOL_F_ADDR) == 0)
+        return node;
+    return -1;
+#else
+    (void)p;
+    return 0;
+#endif
+}
+
+char *map_on_node(size_t n, int node)
+{
+    char *p = pagealloc::map_zeroed(n);
+    if (p)
+        bind(p, pagealloc::round_up(n), node);
+    return p;
+}
+}
@@ -0,0 +1,171 @@
+#include "include/PageAllocator.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/mman.h> // MAP_HUGE_1GB, MAP_HUGE_2MB
+#endif
+
+namespace pagealloc
+{
+size_t page_size() noexcept
+{
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+size_t round_up(size_t n) noexcept
+{
+    const size_t page = page_size();
+    return (n + page - 1) / page * page;
+}
+
+char *map_zeroed(size_t n)
+{
+    if (n == 0)
+        return nullptr;
+    void *mem = mmap(nullptr, round_up(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        throw std::bad_alloc();
+    return static_cast<char *>(mem);
+}
+
+void unmap(char *p, size_t n) noexcept
+{
+    if (p)
+        munmap(p, round_up(n));
+}
+
+bool discard(char *p, size_t n) noexcept
+{
+    return n == 0 || madvise(p, n, MADV_DONTNEED) == 0;
+}
+
+bool wipe_on_fork(char *p, size_t n) noexcept
+{
+#ifdef MADV_WIPEONFORK
+    return madvise(p, n, MADV_WIPEONFORK) == 0;
+#else
+    (void)p;
+    (void)n;
+    errno = EINVAL;
+    return false;
+#endif
+}
+
+size_t round_up_huge(size_t n, Backing backing) noexcept
+{
+    if (backing == Backing::Pages)
+        return round_up(n);
+    const size_t huge = backing == Backing::HugeTlb1G ? GigaPageSize : HugePageSize;
+    return (n + huge - 1) / huge * huge;
+}
+
+namespace
+{
+    // Maps `len` bytes from the hugetlbfs pool; nullptr when the pool (or
+    // the kernel) cannot provide them.
+    char *map_hugetlb(size_t len, int size_flag) noexcept
+    {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        void *mem = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | size_flag, -1, 0);
+        return mem == MAP_FAILED ? nullptr : static_cast<char *>(mem);
+#else
+        (void)len;
+        (void)size_flag;
+        return nullptr;
+#endif
+    }
+
+    // True unless transparent huge pages are compiled out or set to "never".
+    bool thp_available()
+    {
+        static const bool available = [] {
+            std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+            std::string mode;
+            return std::getline(in, mode) && mode.find("[never]") == std::string::npos;
+        }();
+        return available;
+    }
+
+    // Maps `len` bytes (a multiple of 2 MiB) on a 2 MiB boundary, so the
+    // kernel can back the whole range with transparent huge pages, and asks
+    // for them with MADV_HUGEPAGE. Over-maps by one huge page and trims the
+    // unaligned head and tail.
+    char *map_transparent(size_t len) noexcept
+    {
+#ifdef MADV_HUGEPAGE
+        void *mem = mmap(nullptr, len + HugePageSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED)
+            return nullptr;
+        char *raw = static_cast<char *>(mem);
+        char *aligned = reinterpret_cast<char *>(
+            (reinterpret_cast<uintptr_t>(raw) + HugePageSize - 1) & ~uintptr_t(HugePageSize - 1));
+        if (aligned != raw)
+            munmap(raw, aligned - raw);
+        if (size_t tail = (raw + len + HugePageSize) - (aligned + len))
+            munmap(aligned + len, tail);
+        if (madvise(aligned, len, MADV_HUGEPAGE) != 0){
+            munmap(aligned, len);
+            return nullptr;
+        }
+        return aligned;
+#else
+        (void)len;
+        return nullptr;
+#endif
+    }
+}
+
+char *map_huge(size_t n, Backing &backing)
+{
+#ifdef MAP_HUGE_1GB
+    if (n >= GigaPageSize){
+        if (char *p = map_hugetlb(round_up_huge(n, Backing::HugeTlb1G), MAP_HUGE_1GB)){
+            backing = Backing::HugeTlb1G;
+            return p;
+        }
+    }
+#endif
+    const size_t len = round_up_huge(n, Backing::HugeTlb2M);
+#ifdef MAP_HUGE_2MB
+    const int flag_2m = MAP_HUGE_2MB;
+#else
+    const int flag_2m = 0; // the default huge page size
+#endif
+    if (char *p = map_hugetlb(len, flag_2m)){
+        backing = Backing::HugeTlb2M;
+        return p;
+    }
+    if (thp_available()){
+        if (char *p = map_transparent(len)){
+            backing = Backing::Transparent;
+            return p;
+        }
+    }
+    backing = Backing::Pages;
+    return map_zeroed(n);
+}
+
+const char *backing_name(Backing backing) noexcept
+{
+    switch (backing){
+    case Backing::Pages:
+        return "pages";
+    case Backing::Transparent:
+        return "thp";
+    case Backing::HugeTlb2M:
+        return "hugetlb-2M";
+    case Backing::HugeTlb1G:
+        return "hugetlb-1G";
+    }
+    return "unknown";
+}
+}
@@ -0,0 +1,78 @@
+#include "include/SecureArena.hpp"
+#include "include/SecureWipe.hpp"
+#include <cstdint>
+
+SecureArena::SecureArena(size_t chunk_bytes)
+    : chunk_bytes(chunk_bytes ? chunk_bytes : DefaultChunkBytes)
+{
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+    secureview_debug::attach(this);
+#endif
+}
+
+SecureArena::~SecureArena()
+{
+    wipe_used();
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+    secureview_debug::detach(this);
+#endif
+}
+
+// Appends a zeroed chunk of at least `min_bytes`. Chunks start out zero and
+// are wiped back to zero on reset, so allocations never clear memory.
+void SecureArena::add_chunk(size_t min_bytes)
+{
+    const size_t size = min_bytes > chunk_bytes ? min_bytes : chunk_bytes;
+    chunks.reserve(chunks.size() + 1);
+    chunks.push_back(Chunk{std::unique_ptr<char[]>(new char[size]()), size, 0});
+}
+
+SecureSpan SecureArena::allocate(size_t n, size_t align)
+{
+    if (!chunks.empty()){
+        Chunk &c = chunks.back();
+        const uintptr_t base = reinterpret_cast<uintptr_t>(c.mem.get());
+        const size_t offset = ((base + c.used + align - 1) & ~uintptr_t(align - 1)) - base;
+        if (offset <= c.size && n <= c.size - offset){
+            c.used = offset + n;
+            return {reinterpret_cast<std::byte *>(c.mem.get() + offset), n, this};
+        }
+    }
+    // `new char[]` is aligned for max_align_t; over-aligned requests get
+    // enough slack to align inside the chunk.
+    add_chunk(n + (align > alignof(std::max_align_t) ? align : 0));
+    return allocate(n, align);
+}
+
+// One pass per chunk over exactly the bytes handed out.
+void SecureArena::wipe_used() noexcept
+{
+    for (Chunk &c : chunks){
+        securewipe::wipe(c.mem.get(), c.used);
+        c.used = 0;
+    }
+}
+
+void SecureArena::reset() noexcept
+{
+    wipe_used();
+    if (chunks.size() > 1)
+        chunks.resize(1);
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+    secureview_debug::attach(this);
+#endif
+}
+
+size_t SecureArena::bytes_used() const noexcept
+{
+    size_t total = 0;
+    for (const Chunk &c : chunks){
+        total += c.used;
+    }
+    return total;
+}
+
+size_t SecureArena::chunk_count() const noexcept
+{
+    return chunks.size();
+}
@@ -1,58 +1,295 @@
 #include "include/SecureBuffer.hpp"
+#include "include/ConstantTime.hpp"
+#include "include/DeferredWiper.hpp"
+#include "include/LockedArena.hpp"
+#include "include/NonTemporal.hpp"
+#include "include/NumaPlacement.hpp"
+#include "include/PageAllocator.hpp"
+#include "include/SecureIO.hpp"
+#include "include/SecureMetrics.hpp"
+#include "include/SecurePool.hpp"
+#include "include/SecureWipe.hpp"
+#include "include/SecureWipingResource.hpp"
+#include "include/WipeThreadPool.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Runs `wipe`, which zeroes `len` bytes, and records it as one wipe when
+// metrics are enabled (see SecureMetrics.hpp), timed unless latency
+// tracking is off.
+//
+// @param len The number of bytes `wipe` zeroes; zero is never recorded.
+// @param wipe The wipe to run.
+template <typename Wipe>
+void metered_wipe(size_t len, Wipe &&wipe) noexcept
+{
+    if (!securemetrics::enabled() || len == 0) {
+        wipe();
+        return;
+    }
+    if (!securemetrics::wipe_latency_enabled()) {
+        wipe();
+        securemetrics::detail::record_wipe(len);
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    wipe();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    securemetrics::detail::record_wipe(
+        len, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+} // namespace
 
 // Securely wipes a memory buffer to prevent sensitive data from lingering.
 //
 // This is critical for security-sensitive applications (e.g., cryptography,
 // password handling). It ensures that data is overwritten with zeros and
-// can't be recovered by attackers. The use of 'volatile' is key, as it
-// prevents the compiler from optimizing away the write operations, which
-// would otherwise be seen as unnecessary if the memory is immediately
-// deallocated.
+// can't be recovered by attackers.
+//
+// The actual work is done by `securewipe::wipe`, which picks the widest
+// SSE2/AVX2/AVX-512 kernel the CPU supports on first use. The kernels end
+// with a compiler barrier (and the scalar fallback writes through a
+// 'volatile' pointer), so the stores are never optimized away even when the
+// memory is deallocated right afterwards.
+//
+// When metrics are enabled (see SecureMetrics.hpp) each non-empty wipe is
+// also counted and, unless disabled, timed.
 //
 // @param ptr A pointer to the memory buffer to be wiped.
 // @param len The number of bytes to wipe.
 void SecureBuffer::secure_wipe(void *ptr, size_t len) noexcept
 {
-    // Return early if the pointer is null or the length is zero.
-    // This is a good practice to prevent crashes and unnecessary operations.
-    if (!ptr || len == 0)
+    // Null pointers and zero lengths are handled inside `securewipe::wipe`.
+    metered_wipe(ptr ? len : 0, [&] { securewipe::wipe(ptr, len); });
+}
+
+// Whether a wipe of `len` bytes of this buffer's storage can be left to the
+// kernel (see `wipe_storage`).
+//
+// @param len The number of bytes to wipe.
+// @return True if the range would be dropped with MADV_DONTNEED.
+bool SecureBuffer::discards(size_t len) const noexcept
+{
+    return len >= DiscardThreshold &&
+           (storage() == Storage::Mapped ||
+            (storage() == Storage::Huge && page_backing() == pagealloc::Backing::Transparent));
+}
+
+// Wipes `len` bytes at `ptr`, which must lie inside this buffer's storage.
+//
+// Large ranges of kernel-mapped storage (`Storage::Mapped`, and `Storage::Huge`
+// on transparent huge pages) are not written at all: the page-aligned
+// interior is dropped with MADV_DONTNEED, which turns a multi-second wipe of
+// a multi-gigabyte buffer into a page-table update, and only the partial
+// pages at either end are wiped by hand. Dropped pages read back as zero,
+// so the "capacity beyond size is zero" invariant still holds.
+//
+// @param ptr Start of the range to wipe.
+// @param len The number of bytes to wipe.
+void SecureBuffer::wipe_storage(char *ptr, size_t len) noexcept
+{
+    if (!discards(len)) {
+        secure_wipe(ptr, len);
         return;
+    }
+    // Counted as one wipe of `len` bytes, like `secure_wipe`.
+    metered_wipe(len, [&] {
+        const size_t page = pagealloc::page_size();
+        char *first = ptr + (page - reinterpret_cast<uintptr_t>(ptr) % page) % page;
+        char *last = ptr + len - reinterpret_cast<uintptr_t>(ptr + len) % page;
+        if (!pagealloc::discard(first, last - first)) {
+            securewipe::wipe(ptr, len);
+            return;
+        }
+        securewipe::wipe(ptr, first - ptr);
+        securewipe::wipe(last, ptr + len - last);
+    });
+}
 
-    // Use a 'volatile char*' pointer to ensure each byte write is not optimized out by the compiler.
-    // 'volatile' tells the compiler that the value can change at any time due to external factors,
-    // so it must read/write to the memory location for every access.
-    volatile char *p = reinterpret_cast<volatile char *>(ptr);
+// Allocates zeroed storage for `s` bytes from the requested source.
+//
+// Every path hands back memory that is already zero: `new char[s]()`
+// value-initializes, while the pool and the locked arena only hand out wiped
+// blocks or fresh, zero-filled pages. `Storage::Mapped` writes nothing at all:
+// untouched anonymous pages read as zero until first written. Resource
+// memory is cleared here.
+//
+// The whole capacity is zero, not just the first `s` bytes, which is what
+// lets `resize` grow in place without another clearing pass.
+//
+// @param s The size (in bytes) of the buffer.
+// @param storage The preferred storage; sizes it cannot serve use the heap.
+// @param mr The resource to allocate from (`Storage::Resource` only).
+// @return The owning pointer, with a deleter that knows how to release it.
+std::unique_ptr<char[], SecureBuffer::StorageDeleter> SecureBuffer::allocate(size_t s, Storage storage,
+                                                                             std::pmr::memory_resource *mr,
+                                                                             int node)
+{
+    std::unique_ptr<char[], StorageDeleter> block(nullptr, StorageDeleter{});
+    if (storage == Storage::Resource) {
+        const size_t cap = s ? s : 1;
+        char *p = static_cast<char *>(mr->allocate(cap, alignof(std::max_align_t)));
+        std::memset(p, 0, cap);
+        block = {p, StorageDeleter{.storage = Storage::Resource, .resource_wipes = SecureWipingResource::wipes_buffers(mr),
+                                   .capacity = cap, .resource = mr}};
+    } else if (storage == Storage::Pool && SecurePool::fits(s)) {
+        block = {SecurePool::instance().allocate(s), StorageDeleter{.storage = Storage::Pool, .capacity = SecurePool::block_size(s)}};
+    } else if (storage == Storage::Inline && s <= InlineCapacity) {
+        // No allocation: the constructor zeroes `inline_data` instead.
+        return {nullptr, StorageDeleter{.storage = Storage::Inline, .capacity = InlineCapacity}};
+    } else if (storage == Storage::Huge && s >= pagealloc::HugePageSize) {
+        // Falls back to ordinary pages, i.e. `Storage::Mapped`, when neither
+        // hugetlbfs pages nor transparent huge pages are available.
+        pagealloc::Backing backing;
+        char *p = pagealloc::map_huge(s, backing);
+        if (backing == pagealloc::Backing::Pages) {
+            block = {p, StorageDeleter{.storage = Storage::Mapped, .capacity = pagealloc::round_up(s)}};
+        } else {
+            block = {p, StorageDeleter{.storage = Storage::Huge, .backing = backing, .capacity = pagealloc::round_up_huge(s, backing)}};
+        }
+    } else if (storage == Storage::Numa) {
+        // Small sizes come from the node's own pool; larger ones are mapped
+        // with a node policy (a whole page, so never mistaken for a pool block).
+        if (node < 0 || node >= numa::node_count())
+            node = numa::current_node();
+        if (SecurePool::fits(s)) {
+            block = {SecurePool::for_node(node).allocate(s),
+                     StorageDeleter{.storage = Storage::Numa, .node = short(node), .capacity = SecurePool::block_size(s)}};
+        } else {
+            block = {numa::map_on_node(s, node),
+                     StorageDeleter{.storage = Storage::Numa, .node = short(node), .capacity = pagealloc::round_up(s)}};
+        }
+    } else if (char *p = storage == Storage::WipeOnFork && LockedArena::fits(s)
+                             ? LockedArena::fork_instance().allocate(s) : nullptr) {
+        block = {p, StorageDeleter{.storage = Storage::WipeOnFork, .capacity = LockedArena::block_size(s)}};
+    } else if (storage == Storage::WipeOnFork) {
+        // Large sizes, and small ones once the arena cannot lock more, get
+        // their own unlocked mapping: losing `mlock` is better than handing
+        // the secret to every child. On kernels without MADV_WIPEONFORK it
+        // stays an ordinary `Storage::Mapped` buffer.
+        char *p = pagealloc::map_zeroed(s);
+        const bool marked = pagealloc::wipe_on_fork(p, pagealloc::round_up(s));
+        block = {p, StorageDeleter{.storage = marked ? Storage::WipeOnFork : Storage::Mapped, .mapped = true,
+                                   .capacity = pagealloc::round_up(s)}};
+    } else if (storage == Storage::Mapped || storage == Storage::Huge) {
+        block = {pagealloc::map_zeroed(s), StorageDeleter{.storage = Storage::Mapped, .capacity = pagealloc::round_up(s)}};
+    } else if (char *p = storage == Storage::Secret ? LockedArena::secret_instance().allocate(s) : nullptr) {
+        block = {p, StorageDeleter{.storage = Storage::Secret, .capacity = LockedArena::block_size(s)}};
+    } else if (char *p = storage == Storage::Locked || storage == Storage::Secret
+                             ? LockedArena::instance().allocate(s) : nullptr) {
+        // Also the fallback for `Storage::Secret` on kernels without
+        // memfd_secret.
+        block = {p, StorageDeleter{.storage = Storage::Locked, .capacity = LockedArena::block_size(s)}};
+    } else {
+        // Also the fallback once RLIMIT_MEMLOCK is used up for `Storage::Locked`.
+        block = {new char[s](), StorageDeleter{.storage = Storage::Heap, .capacity = s}};
+    }
+    securemetrics::on_allocation(block.get_deleter().capacity);
+    return block;
+}
 
-    // Loop through each byte and overwrite it with a null character (0).
-    // The `len--` in the `while` loop condition is a common and efficient
-    // way to count down and iterate through the buffer.
-    while (len--){
-        *p++ = 0;
+// Releases storage after the owning SecureBuffer has wiped it.
+void SecureBuffer::StorageDeleter::operator()(char *p) const noexcept
+{
+    securemetrics::on_release(capacity);
+    switch (storage) {
+    case Storage::Pool:
+        SecurePool::instance().release(p, capacity);
+        break;
+    case Storage::Locked:
+        LockedArena::instance().release(p, capacity);
+        break;
+    case Storage::Secret:
+        LockedArena::secret_instance().release(p, capacity);
+        break;
+    case Storage::WipeOnFork:
+        if (mapped)
+            pagealloc::unmap(p, capacity);
+        else
+            LockedArena::fork_instance().release(p, capacity);
+        break;
+    case Storage::Mapped:
+    case Storage::Huge:
+        pagealloc::unmap(p, capacity);
+        break;
+    case Storage::Heap:
+        delete[] p;
+        break;
+    case Storage::Inline:
+        // Never owns a pointer; nothing to release.
+        break;
+    case Storage::Resource:
+        resource->deallocate(p, capacity, alignof(std::max_align_t));
+        break;
+    case Storage::Numa:
+        if (SecurePool::fits(capacity))
+            SecurePool::for_node(node).release(p, capacity);
+        else
+            pagealloc::unmap(p, capacity);
+        break;
     }
 }
 
 // Constructor for SecureBuffer.
-// It allocates a new buffer of a specified size and immediately zeroes it out.
-// This is a crucial step for a secure buffer, as it ensures that the allocated
-// memory doesn't contain any leftover, sensitive data from previous operations.
+// It allocates a new, zeroed buffer of a specified size. This is a crucial
+// step for a secure buffer, as it ensures that the allocated memory doesn't
+// contain any leftover, sensitive data from previous operations.
+//
+// Buffers of up to `InlineCapacity` bytes (keys, nonces) live inside the object,
+// avoiding a heap allocation and the pointer chase on access. Medium buffers
+// come from the heap. Buffers of `MappedThreshold` bytes or more are mapped
+// directly: the kernel already hands out zeroed pages, so large buffers skip
+// the zero-fill pass entirely and only pay for pages they touch.
 //
 // @param s The size (in bytes) of the buffer to be created.
 SecureBuffer::SecureBuffer(size_t s)
-    // Use an initializer list to initialize member variables `data` and `size`.
-    // This is generally more efficient and is the preferred method in C++.
-    : data(std::make_unique<char[]>(s)), size(s)
-{
-
-    // Check if memory allocation was successful. `std::make_unique` will throw
-    // `std::bad_alloc` on failure, but this check provides an extra layer of
-    // defensive programming.
-    if (data){
-        // Use `std::fill` to efficiently overwrite the entire buffer with zeros.
-        // This ensures the buffer is in a known, safe state from the moment of
-        // its creation.
-        std::fill(data.get(), data.get() + size, 0);
+    : SecureBuffer(s, s <= InlineCapacity ? Storage::Inline
+                      : s >= MappedThreshold ? Storage::Mapped
+                                             : Storage::Heap)
+{
+}
+
+// Constructor with an explicit storage policy.
+// `Storage::Pool` serves 1..4096 byte buffers from `SecurePool`, so request
+// handlers that create and drop many small secrets reuse wiped blocks instead
+// of going through the global allocator each time.
+//
+// `Storage::Numa` places the buffer on `node`, so a worker pinned to one
+// socket does not pay cross-socket latency on every access to its secrets.
+//
+// @param s The size (in bytes) of the buffer to be created.
+// @param storage Where to allocate the buffer from.
+// @param node The NUMA node for `Storage::Numa`; -1 means the current one.
+SecureBuffer::SecureBuffer(size_t s, Storage storage, int node)
+    // `allocate` throws `std::bad_alloc` on failure, so a constructed
+    // SecureBuffer always owns valid, zeroed memory.
+    : data(allocate(s, storage, nullptr, node)), size(s)
+{
+    if (this->storage() == Storage::Inline) {
+        std::memset(inline_data, 0, InlineCapacity);
     }
+    securemetrics::on_construction();
+    storage_changed();
+}
+
+// Constructor for memory-resource backed buffers.
+// Lets callers route secret storage through their own allocators, such as a
+// request-scoped arena whose memory is released all at once.
+//
+// @param s The size (in bytes) of the buffer to be created.
+// @param mr The resource to allocate from; must outlive the buffer.
+SecureBuffer::SecureBuffer(size_t s, std::pmr::memory_resource *mr)
+    : data(allocate(s, Storage::Resource, mr)), size(s)
+{
+    securemetrics::on_construction();
+    storage_changed();
 }
 
 // Move constructor for SecureBuffer.
@@ -74,6 +311,28 @@ SecureBuffer::SecureBuffer(SecureBuffer &&other) noexcept
     // from attempting to free the memory that has now been moved.
     // The `other` object is now in a valid, empty state.
     size(std::exchange(other.size, 0)) {
+    take_inline(other);
+    securemetrics::on_move();
+    storage_changed();
+    other.storage_changed();
+}
+
+// Completes a move from an inline buffer.
+// Inline bytes live inside `other` itself, so moving the (null) `unique_ptr`
+// does not carry them over. They are copied into this object and then wiped
+// in `other`, so the moved-from object never keeps a copy of the secret.
+// The rest of our `inline_data` is zeroed: it may hold whatever this object
+// had before (or nothing initialized at all), and growing in place relies
+// on the bytes beyond `size` being zero.
+//
+// @param other The moved-from buffer; `size` has already been taken from it.
+void SecureBuffer::take_inline(SecureBuffer &other) noexcept
+{
+    if (storage() == Storage::Inline) {
+        std::memcpy(inline_data, other.inline_data, size);
+        secure_wipe(inline_data + size, InlineCapacity - size);
+        secure_wipe(other.inline_data, size);
+    }
 }
 
 // Move assignment operator.
@@ -88,37 +347,220 @@ SecureBuffer& SecureBuffer::operator=(SecureBuffer &&other) noexcept
     // The "self-assignment check" is a standard practice to prevent issues
     if (this != &other) {
         // Step 1: Securely wipe the data of the current object.
-        secure_wipe(data.get(), size);
-
-        // Step 2: Swap the contents. `std::swap` is a powerful tool here.
-        // It efficiently exchanges the pointers and sizes between the two objects.
-        // The `other` object's data and size now hold the old values of `*this`.
-        using std::swap;
-        swap(data, other.data);
-        swap(size, other.size);
+        wipe_storage(data_ptr(), size);
+
+        // Step 2: Take over the source's buffer. Assigning the `unique_ptr`
+        // frees our (now wiped) old block, and `std::exchange` leaves the
+        // `other` object in a valid, empty state, just like the move constructor.
+        data = std::move(other.data);
+        size = std::exchange(other.size, 0);
+
+        // Step 3: Inline bytes are copied over and wiped in `other`.
+        take_inline(other);
+        securemetrics::on_move();
+        storage_changed();
+        other.storage_changed();
     }
     return *this;
 }
 
+// Picks the storage for a grown block: the same source as before where that
+// source can serve the new capacity, otherwise the default heap / mapped split.
+SecureBuffer::Storage SecureBuffer::growth_storage(size_t cap) const noexcept
+{
+    switch (storage()) {
+    case Storage::Pool:
+    case Storage::Locked:
+    case Storage::Secret:
+    case Storage::WipeOnFork:
+    case Storage::Resource:
+    case Storage::Huge:
+    case Storage::Numa:
+        return storage();
+    default:
+        return cap >= MappedThreshold ? Storage::Mapped : Storage::Heap;
+    }
+}
+
+// Moves the contents into a new zeroed block of at least `new_cap` bytes.
+// The old bytes are wiped before the old block is released, so growing never
+// leaves a stale copy of the secret behind. If allocation throws, the buffer
+// is left unchanged.
+//
+// @param new_cap The minimum capacity of the new block.
+void SecureBuffer::reallocate(size_t new_cap)
+{
+    auto fresh = allocate(new_cap, growth_storage(new_cap), data.get_deleter().resource, data.get_deleter().node);
+    char *old = data_ptr();
+    if (size > 0)
+        std::memcpy(fresh.get(), old, size);
+    wipe_storage(old, size);
+    data = std::move(fresh);
+    storage_changed();
+}
+
+// Returns the capacity to grow to for `needed` bytes: at least double the
+// current one, so growth stays geometric, without overflowing.
+//
+// @param needed The size the buffer must be able to hold.
+// @return The new capacity.
+size_t SecureBuffer::grown_capacity(size_t needed) const
+{
+    if (needed > max_size())
+        throw std::length_error("SecureBuffer size exceeds max_size()");
+    const size_t cap = capacity();
+    return cap <= max_size() / 2 ? std::max(needed, 2 * cap) : needed;
+}
+
+// Grows the capacity to at least `n` bytes without changing the size.
+//
+// @param n The requested capacity in bytes.
+void SecureBuffer::reserve(size_t n)
+{
+    if (n > max_size())
+        throw std::length_error("SecureBuffer size exceeds max_size()");
+    if (n > capacity()) {
+        reallocate(n);
+    }
+}
+
+// Changes the size to `n` bytes.
+// Growing exposes zero bytes (the capacity beyond `size` is always zero) and
+// reallocates geometrically when needed. Shrinking wipes the dropped tail so
+// the invariant holds and no secret survives past the new end.
+//
+// @param n The new size in bytes.
+void SecureBuffer::resize(size_t n)
+{
+    if (n < size) {
+        wipe_storage(data_ptr() + n, size - n);
+        storage_changed();
+    } else if (n > capacity()) {
+        reallocate(grown_capacity(n));
+    }
+    size = n;
+}
+
+// Appends `len` bytes from `src`, doubling the capacity when it runs out so a
+// stream of appends costs amortized O(1) per byte.
+//
+// @param src The bytes to append; must not point into this buffer.
+// @param len The number of bytes to append.
+void SecureBuffer::append(const void *src, size_t len)
+{
+    if (len > capacity() - size) {
+        if (len > max_size() - size)
+            throw std::length_error("SecureBuffer size exceeds max_size()");
+        reallocate(grown_capacity(size + len));
+    }
+    std::memcpy(data_ptr() + size, src, len);
+    size += len;
+}
+
+// Wipes the contents with the process-wide `WipeThreadPool`.
+void SecureBuffer::parallel_wipe()
+{
+    parallel_wipe(WipeThreadPool::instance());
+}
+
+// Wipes the contents with `pool`: the buffer is split into page-aligned
+// chunks that the pool threads zero concurrently, which scales a
+// tens-of-gigabytes wipe with memory bandwidth instead of one core. The
+// size drops to zero afterwards, so destruction has nothing left to wipe.
+//
+// @param pool The threads to wipe with.
+void SecureBuffer::parallel_wipe(WipeThreadPool &pool)
+{
+    // Storage the kernel can drop is faster to discard than to write.
+    if (discards(size)) {
+        wipe_storage(data_ptr(), size);
+    } else {
+        // Counted as one wipe, like `secure_wipe`.
+        metered_wipe(size, [&] { pool.wipe(data_ptr(), size); });
+    }
+    size = 0;
+    storage_changed();
+}
+
+// Overwrites part of the buffer in place.
+// Bulk fills (for example loading a multi-hundred-MB key store) use
+// streaming stores above `nontemporal::threshold()`, so they do not evict
+// the rest of the process's hot data from the cache.
+//
+// @param offset Where to start writing.
+// @param src The bytes to copy; must not overlap the destination.
+// @param len The number of bytes to copy.
+void SecureBuffer::write(size_t offset, const void *src, size_t len)
+{
+    if (offset > size || len > size - offset)
+        throw std::out_of_range("SecureBuffer::write out of range");
+    if (len >= nontemporal::threshold()) {
+        nontemporal::copy(data_ptr() + offset, src, len);
+    } else {
+        std::memcpy(data_ptr() + offset, src, len);
+    }
+}
+
+// Fills the buffer from `fd` without a staging copy (see SecureIO.hpp).
+//
+// @param fd The descriptor to read from.
+// @return Bytes read; fewer than `size_bytes()` only at end of file.
+size_t SecureBuffer::read_from(int fd)
+{
+    return secureio::read_from(fd, data_ptr(), size);
+}
+
+// Writes the whole contents to `fd`.
+//
+// @param fd The descriptor to write to.
+// @return Bytes written.
+size_t SecureBuffer::write_to(int fd) const
+{
+    return secureio::write_to(fd, data_ptr(), size);
+}
+
+// Invalidates existing views in debug builds (see SecureSpan.hpp); a no-op
+// otherwise.
+void SecureBuffer::storage_changed() noexcept
+{
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+    secureview_debug::attach(this);
+#endif
+}
+
 // Destructor for SecureBuffer.
 // This function is automatically called when a SecureBuffer object goes out of scope,
 // is explicitly deleted, or its lifetime ends for any reason.
 SecureBuffer::~SecureBuffer()
 {
+    // Large buffers may be handed to the background wiper instead (opt-in,
+    // see DeferredWiper). Moving out leaves this object empty, so the rest
+    // of the destructor has nothing left to wipe.
+    if (size > InlineCapacity) {
+        DeferredWiper::instance().try_defer(*this);
+    }
+
     // Call the `secure_wipe` function to zero out the memory buffer.
     // This is a critical step for a secure buffer. It prevents sensitive data
     // from remaining in memory after the object is destroyed, which could
     // otherwise be recovered by an attacker.
     // The `unique_ptr`'s destructor will be called automatically after this
-    // function finishes, handling the `delete[]` operation for the underlying data.
-    secure_wipe(data.get(), size);
+    // function finishes, and its deleter returns the wiped memory to the heap
+    // or to the pool it came from. Inline bytes are wiped in place.
+    // Buffers in an arena whose release wipes every chunk (opt-in, see
+    // SecureWipingResource) leave the wipe to that release.
+    if (!data.get_deleter().resource_wipes)
+        wipe_storage(data_ptr(), size);
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+    secureview_debug::detach(this);
+#endif
 }
 
 // Returns a non-const pointer to the managed buffer.
 // This allows for modification of the buffer's contents.
 char* SecureBuffer::data_ptr() noexcept
 {
-    return data.get();
+    return storage() == Storage::Inline ? inline_data : data.get();
 }
 
 // Overloaded `const` version of `data_ptr`.
@@ -127,7 +569,7 @@ char* SecureBuffer::data_ptr() noexcept
 // for providing read-only access to internal data.
 const char* SecureBuffer::data_ptr() const noexcept
 {
-    return data.get();
+    return storage() == Storage::Inline ? inline_data : data.get();
 }
 
 // Returns the size of the buffer in bytes.
@@ -145,3 +587,66 @@ size_t SecureBuffer::size_bytes() const noexcept
     // Return the value of the `size` member variable.
     return size;
 }
+
+// Compares the contents with another buffer in constant time.
+// Sizes are not secret, so a size mismatch returns early; equal-sized
+// buffers are compared with `consttime::equal`, which reads every byte.
+//
+// @param other The buffer to compare with.
+// @return True if both buffers hold the same bytes.
+bool SecureBuffer::constant_time_equal(const SecureBuffer &other) const noexcept
+{
+    return constant_time_equal(other.data_ptr(), other.size);
+}
+
+// Compares the contents with `len` bytes at `bytes` in constant time.
+bool SecureBuffer::constant_time_equal(const void *bytes, size_t len) const noexcept
+{
+    if (len != size)
+        return false;
+    return consttime::equal(data_ptr(), bytes, len);
+}
+
+// Returns a mutable, non-owning view of the buffer's bytes.
+SecureSpan SecureBuffer::span() noexcept
+{
+    return {reinterpret_cast<std::byte *>(data_ptr()), size, this};
+}
+
+// Returns a read-only, non-owning view of the buffer's bytes.
+SecureConstSpan SecureBuffer::span() const noexcept
+{
+    return {reinterpret_cast<const std::byte *>(data_ptr()), size, this};
+}
+
+// Returns the number of bytes the buffer can hold without reallocating.
+size_t SecureBuffer::capacity() const noexcept
+{
+    if (storage() == Storage::Inline)
+        return InlineCapacity;
+    return data ? data.get_deleter().capacity : 0;
+}
+
+// Returns where the buffer's storage was allocated from.
+SecureBuffer::Storage SecureBuffer::storage() const noexcept
+{
+    return data.get_deleter().storage;
+}
+
+// Returns the page size backing the buffer (see `pagealloc::Backing`).
+pagealloc::Backing SecureBuffer::page_backing() const noexcept
+{
+    return data.get_deleter().backing;
+}
+
+// Returns whether any wipe of this buffer's storage can be a discard.
+bool SecureBuffer::discards_pages() const noexcept
+{
+    return discards(capacity());
+}
+
+// Returns the NUMA node of a `Storage::Numa` buffer, -1 for other storage.
+int SecureBuffer::numa_node() const noexcept
+{
+    return storage() == Storage::Numa ? data.get_deleter().node : -1;
+}
@@ -0,0 +1,86 @@
+#include "include/SecureIO.hpp"
+#include <cerrno>
+#include <climits>
+#include <system_error>
+#include <sys/uio.h>
+#include <vector>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+namespace
+{
+    // Moves every byte described by `iov[0..count)`, calling `readv` or
+    // `writev` as often as needed. After a short transfer the fully
+    // transferred entries are skipped and the partial one is advanced in
+    // place, so the next call resumes exactly where the kernel stopped.
+    //
+    // @return Bytes transferred; short only when a read hits end of file.
+    size_t transfer(int fd, iovec *iov, size_t count, bool writing)
+    {
+        size_t total = 0;
+        while (count > 0){
+            const int batch = count < IOV_MAX ? static_cast<int>(count) : IOV_MAX;
+            const ssize_t n = writing ? ::writev(fd, iov, batch) : ::readv(fd, iov, batch);
+            if (n < 0){
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), writing ? "writev" : "readv");
+            }
+            if (n == 0 && !writing)
+                break; // end of file
+            total += static_cast<size_t>(n);
+            size_t left = static_cast<size_t>(n);
+            while (count > 0 && left >= iov->iov_len){
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0){
+                iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+        return total;
+    }
+
+    template <typename Buffers>
+    std::vector<iovec> gather(Buffers bufs)
+    {
+        std::vector<iovec> iov;
+        iov.reserve(bufs.size());
+        for (auto &b : bufs){
+            if (b.size_bytes() > 0)
+                iov.push_back(iovec{const_cast<char *>(b.data_ptr()), b.size_bytes()});
+        }
+        return iov;
+    }
+}
+
+namespace secureio
+{
+size_t read_from(int fd, std::span<SecureBuffer> bufs)
+{
+    std::vector<iovec> iov = gather(bufs);
+    return transfer(fd, iov.data(), iov.size(), false);
+}
+
+size_t write_to(int fd, std::span<const SecureBuffer> bufs)
+{
+    std::vector<iovec> iov = gather(bufs);
+    return transfer(fd, iov.data(), iov.size(), true);
+}
+
+size_t read_from(int fd, void *dst, size_t len)
+{
+    iovec iov{dst, len};
+    return transfer(fd, &iov, len > 0 ? 1 : 0, false);
+}
+
+size_t write_to(int fd, const void *src, size_t len)
+{
+    iovec iov{const_cast<void *>(src), len};
+    return transfer(fd, &iov, len > 0 ? 1 : 0, true);
+}
+}
@@ -0,0 +1,238 @@
+#include "include/SecureMetrics.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace securemetrics
+{
+namespace detail
+{
+    std::atomic<bool> active{false};
+    std::atomic<bool> timed{false};
+}
+
+namespace
+{
+    // One thread's counters. Only the owning thread writes, `snapshot()`
+    // reads them concurrently, hence relaxed atomics without RMW.
+    struct ThreadCounters
+    {
+        std::atomic<uint64_t> constructions{0};
+        std::atomic<uint64_t> moves{0};
+        std::atomic<uint64_t> bytes_allocated{0};
+        std::atomic<uint64_t> bytes_released{0};
+        std::atomic<uint64_t> bytes_wiped{0};
+        std::atomic<uint64_t> wipes{0};
+        std::array<std::atomic<uint64_t>, HistogramBuckets> wipe_latency{};
+    };
+
+    inline void add(std::atomic<uint64_t> &counter, uint64_t n) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void accumulate(Snapshot &total, const ThreadCounters &tc) noexcept
+    {
+        total.constructions += tc.constructions.load(std::memory_order_relaxed);
+        total.moves += tc.moves.load(std::memory_order_relaxed);
+        total.bytes_allocated += tc.bytes_allocated.load(std::memory_order_relaxed);
+        total.bytes_released += tc.bytes_released.load(std::memory_order_relaxed);
+        total.bytes_wiped += tc.bytes_wiped.load(std::memory_order_relaxed);
+        total.wipes += tc.wipes.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < HistogramBuckets; ++i){
+            total.wipe_latency[i] += tc.wipe_latency[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Live per-thread counters plus the totals of threads that have exited.
+    // Leaked on purpose so buffers destroyed during static destruction can
+    // still record.
+    struct Registry
+    {
+        std::mutex lock;
+        std::vector<ThreadCounters *> threads;
+        Snapshot retired;
+
+        static Registry &instance()
+        {
+            static Registry *r = new Registry();
+            return *r;
+        }
+    };
+
+    // Thread-exit hook: folds the thread's counters into `retired`.
+    // `tls_exited` is trivially destructible, so records made after the
+    // owner is gone are dropped instead of touching freed counters.
+    struct ThreadCountersOwner
+    {
+        ThreadCounters *counters = nullptr;
+        ~ThreadCountersOwner();
+    };
+    thread_local ThreadCountersOwner tls_owner;
+    thread_local bool tls_exited = false;
+
+    ThreadCountersOwner::~ThreadCountersOwner()
+    {
+        tls_exited = true;
+        if (!counters)
+            return;
+        Registry &r = Registry::instance();
+        {
+            std::lock_guard<std::mutex> guard(r.lock);
+            accumulate(r.retired, *counters);
+            r.threads.erase(std::find(r.threads.begin(), r.threads.end(), counters));
+        }
+        delete counters;
+        counters = nullptr;
+    }
+
+    ThreadCounters *local() noexcept
+    {
+        if (tls_exited)
+            return nullptr;
+        ThreadCountersOwner &owner = tls_owner;
+        if (!owner.counters){
+            ThreadCounters *tc = new (std::nothrow) ThreadCounters();
+            if (!tc)
+                return nullptr;
+            Registry &r = Registry::instance();
+            std::lock_guard<std::mutex> guard(r.lock);
+            try {
+                r.threads.push_back(tc);
+            } catch (...) {
+                delete tc;
+                return nullptr;
+            }
+            owner.counters = tc;
+        }
+        return owner.counters;
+    }
+
+    // Smallest i with ns <= 2^i, so a wipe of exactly 2^i ns lands in the
+    // bucket labelled le=2^i.
+    size_t latency_bucket(uint64_t ns) noexcept
+    {
+        return ns <= 1 ? 0 : std::min<size_t>(std::bit_width(ns - 1), HistogramBuckets - 1);
+    }
+
+    // Formats a sample value; `std::to_string(double)` would round
+    // nanosecond bounds down to "0.000000".
+    std::string format_value(double v)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.9g", v);
+        return buf;
+    }
+}
+
+namespace detail
+{
+    void record_construction() noexcept
+    {
+        if (ThreadCounters *tc = local())
+            add(tc->constructions, 1);
+    }
+
+    void record_move() noexcept
+    {
+        if (ThreadCounters *tc = local())
+            add(tc->moves, 1);
+    }
+
+    void record_allocation(size_t bytes) noexcept
+    {
+        if (ThreadCounters *tc = local())
+            add(tc->bytes_allocated, bytes);
+    }
+
+    void record_release(size_t bytes) noexcept
+    {
+        if (ThreadCounters *tc = local())
+            add(tc->bytes_released, bytes);
+    }
+
+    void record_wipe(size_t bytes) noexcept
+    {
+        if (ThreadCounters *tc = local()){
+            add(tc->bytes_wiped, bytes);
+            add(tc->wipes, 1);
+        }
+    }
+
+    void record_wipe(size_t bytes, uint64_t nanoseconds) noexcept
+    {
+        if (ThreadCounters *tc = local()){
+            add(tc->bytes_wiped, bytes);
+            add(tc->wipes, 1);
+            add(tc->wipe_latency[latency_bucket(nanoseconds)], 1);
+        }
+    }
+}
+
+void enable(bool wipe_latency) noexcept
+{
+    detail::timed.store(wipe_latency, std::memory_order_relaxed);
+    detail::active.store(true, std::memory_order_relaxed);
+}
+
+void disable() noexcept
+{
+    detail::active.store(false, std::memory_order_relaxed);
+}
+
+Snapshot snapshot()
+{
+    Registry &r = Registry::instance();
+    std::lock_guard<std::mutex> guard(r.lock);
+    Snapshot total = r.retired;
+    for (const ThreadCounters *tc : r.threads){
+        accumulate(total, *tc);
+    }
+    return total;
+}
+
+std::string to_prometheus(const Snapshot &s, const std::string &prefix)
+{
+    std::string out;
+    auto counter = [&](const char *name, const char *help, uint64_t value){
+        const std::string metric = prefix + "_" + name;
+        out += "# HELP " + metric + " " + help + "\n";
+        out += "# TYPE " + metric + " counter\n";
+        out += metric + " " + std::to_string(value) + "\n";
+    };
+    counter("constructions_total", "SecureBuffer constructions.", s.constructions);
+    counter("moves_total", "SecureBuffer move constructions and assignments.", s.moves);
+    counter("allocated_bytes_total", "Bytes of storage allocated.", s.bytes_allocated);
+    counter("released_bytes_total", "Bytes of storage released.", s.bytes_released);
+    counter("wiped_bytes_total", "Bytes securely wiped.", s.bytes_wiped);
+    counter("wipes_total", "Secure wipes, whether timed or not.", s.wipes);
+
+    const std::string live = prefix + "_live_bytes";
+    out += "# HELP " + live + " Bytes currently held by SecureBuffers.\n";
+    out += "# TYPE " + live + " gauge\n";
+    out += live + " " + std::to_string(s.live_bytes()) + "\n";
+
+    // Histogram buckets are cumulative and labelled by their upper bound in
+    // seconds. The sum is not tracked, so it is approximated by the bucket
+    // midpoints; it is only meant for rough averages.
+    const std::string hist = prefix + "_wipe_duration_seconds";
+    out += "# HELP " + hist + " Latency of individual secure wipes.\n";
+    out += "# TYPE " + hist + " histogram\n";
+    uint64_t cumulative = 0;
+    double approx_sum = 0;
+    for (size_t i = 0; i + 1 < HistogramBuckets; ++i){
+        cumulative += s.wipe_latency[i];
+        const double upper_ns = static_cast<double>(uint64_t(1) << i);
+        approx_sum += s.wipe_latency[i] * (i ? upper_ns * 0.75 : 0.5);
+        out += hist + "_bucket{le=\"" + format_value(upper_ns * 1e-9) + "\"} " + std::to_string(cumulative) + "\n";
+    }
+    cumulative += s.wipe_latency[HistogramBuckets - 1];
+    approx_sum += s.wipe_latency[HistogramBuckets - 1] * static_cast<double>(uint64_t(1) << (HistogramBuckets - 1));
+    out += hist + "_bucket{le=\"+Inf\"} " + std::to_string(cumulative) + "\n";
+    out += hist + "_sum " + format_value(approx_sum * 1e-9) + "\n";
+    out += hist + "_count " + std::to_string(cumulative) + "\n";
+    return out;
+}
+}
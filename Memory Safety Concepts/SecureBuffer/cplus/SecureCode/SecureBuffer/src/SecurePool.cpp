@@ -0,0 +1,284 @@
+#include "include/SecurePool.hpp"
+#include "include/NumaPlacement.hpp"
+#include "include/PageAllocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    constexpr std::align_val_t SlabAlign{64};
+
+    // Single-writer counter bump: only the owning thread writes, other
+    // threads only read in `stats()`, so no atomic read-modify-write is needed.
+    inline void bump(std::atomic<uint64_t> &counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+thread_local SecurePool::ThreadCacheOwner SecurePool::tls_owner;
+thread_local bool SecurePool::tls_exited = false;
+
+SecurePool::SecurePool(bool thread_caches, int node)
+    : use_thread_caches(thread_caches), node(node)
+{
+}
+
+// Frees every slab. Outstanding blocks become dangling, so only pools whose
+// buffers are all gone may be destroyed (the global instance never is).
+SecurePool::~SecurePool()
+{
+    for (char *slab : slabs){
+        free_slab(slab);
+    }
+}
+
+SecurePool &SecurePool::instance()
+{
+    static SecurePool *pool = new SecurePool(true);
+    return *pool;
+}
+
+SecurePool &SecurePool::for_node(int node)
+{
+    static std::array<std::atomic<SecurePool *>, numa::MaxNodes> pools{};
+    static std::mutex create_lock;
+    if (node < 0 || node >= numa::node_count())
+        node = 0;
+    if (SecurePool *pool = pools[node].load(std::memory_order_acquire))
+        return *pool;
+    std::lock_guard<std::mutex> guard(create_lock);
+    if (!pools[node].load(std::memory_order_relaxed))
+        pools[node].store(new SecurePool(false, node), std::memory_order_release);
+    return *pools[node].load(std::memory_order_relaxed);
+}
+
+bool SecurePool::fits(size_t n) noexcept
+{
+    return n > 0 && n <= MaxBlock;
+}
+
+size_t SecurePool::block_size(size_t n) noexcept
+{
+    return MinBlock << class_index(n);
+}
+
+// Maps a request size to its class: 1..32 -> 0, 33..64 -> 1, ..., 2049..4096 -> 7.
+size_t SecurePool::class_index(size_t n) noexcept
+{
+    size_t idx = 0;
+    size_t block = MinBlock;
+    while (block < n){
+        block <<= 1;
+        ++idx;
+    }
+    return idx;
+}
+
+// Returns a zeroed slab: from the heap, or for node pools a mapping whose
+// pages prefer the pool's node (zero until first written).
+char *SecurePool::allocate_slab()
+{
+    if (node >= 0)
+        return numa::map_on_node(SlabBytes, node);
+    char *slab = static_cast<char *>(::operator new[](SlabBytes, SlabAlign));
+    std::memset(slab, 0, SlabBytes);
+    return slab;
+}
+
+void SecurePool::free_slab(char *slab) noexcept
+{
+    if (node >= 0)
+        pagealloc::unmap(slab, SlabBytes);
+    else
+        ::operator delete[](slab, SlabAlign);
+}
+
+// Carves a fresh zeroed slab into blocks and pushes them onto the free list.
+// Called with `sc.lock` held.
+void SecurePool::refill(SizeClass &sc, size_t block)
+{
+    char *slab = allocate_slab();
+    {
+        std::lock_guard<std::mutex> guard(slabs_lock);
+        try {
+            slabs.push_back(slab);
+        } catch (...) {
+            free_slab(slab);
+            throw;
+        }
+    }
+    for (size_t off = SlabBytes; off >= block; off -= block){
+        FreeBlock *b = reinterpret_cast<FreeBlock *>(slab + off - block);
+        b->next = sc.free_list;
+        sc.free_list = b;
+    }
+}
+
+// Shared-list allocation, used by pools without thread caches and by
+// threads whose cache is already gone.
+char *SecurePool::allocate_shared(size_t idx)
+{
+    SizeClass &sc = classes[idx];
+    std::lock_guard<std::mutex> guard(sc.lock);
+    if (sc.free_list){
+        ++sc.hits;
+    } else {
+        ++sc.misses;
+        refill(sc, MinBlock << idx);
+    }
+    FreeBlock *b = sc.free_list;
+    sc.free_list = b->next;
+    return reinterpret_cast<char *>(b);
+}
+
+void SecurePool::release_shared(size_t idx, FreeBlock *b) noexcept
+{
+    SizeClass &sc = classes[idx];
+    std::lock_guard<std::mutex> guard(sc.lock);
+    b->next = sc.free_list;
+    sc.free_list = b;
+    ++sc.releases;
+}
+
+// Returns the calling thread's cache, creating it on first use, or nullptr if
+// this pool has no thread caches (or the thread is exiting).
+SecurePool::ThreadCache *SecurePool::thread_cache() noexcept
+{
+    if (!use_thread_caches || tls_exited)
+        return nullptr;
+    ThreadCacheOwner &owner = tls_owner;
+    if (!owner.cache){
+        ThreadCache *tc = new (std::nothrow) ThreadCache();
+        if (!tc)
+            return nullptr;
+        std::lock_guard<std::mutex> guard(caches_lock);
+        try {
+            caches.push_back(tc);
+        } catch (...) {
+            delete tc;
+            return nullptr;
+        }
+        owner.cache = tc;
+    }
+    return owner.cache;
+}
+
+// Moves up to half a magazine of blocks from the shared list into `mag`,
+// carving a new slab first if the shared list is empty.
+//
+// @return True if a slab had to be carved (the allocation is a miss).
+bool SecurePool::refill_magazine(ThreadCache::Magazine &mag, size_t idx)
+{
+    SizeClass &sc = classes[idx];
+    std::lock_guard<std::mutex> guard(sc.lock);
+    const bool carved = sc.free_list == nullptr;
+    if (carved)
+        refill(sc, MinBlock << idx);
+    while (mag.count < MagazineSize / 2 && sc.free_list){
+        FreeBlock *b = sc.free_list;
+        sc.free_list = b->next;
+        mag.blocks[mag.count++] = b;
+    }
+    return carved;
+}
+
+// Returns all but `keep` blocks of `mag` to the shared list in one locked step.
+void SecurePool::flush_magazine(ThreadCache::Magazine &mag, size_t idx, uint32_t keep) noexcept
+{
+    if (mag.count <= keep)
+        return;
+    SizeClass &sc = classes[idx];
+    std::lock_guard<std::mutex> guard(sc.lock);
+    while (mag.count > keep){
+        FreeBlock *b = mag.blocks[--mag.count];
+        b->next = sc.free_list;
+        sc.free_list = b;
+    }
+}
+
+// Hands an exiting thread's blocks back to the shared lists and folds its
+// counters into the pool totals.
+void SecurePool::retire_thread_cache(ThreadCache *tc) noexcept
+{
+    for (size_t idx = 0; idx < NumClasses; ++idx){
+        flush_magazine(tc->magazines[idx], idx, 0);
+    }
+    {
+        std::lock_guard<std::mutex> guard(caches_lock);
+        retired_hits += tc->hits.load(std::memory_order_relaxed);
+        retired_misses += tc->misses.load(std::memory_order_relaxed);
+        retired_releases += tc->releases.load(std::memory_order_relaxed);
+        caches.erase(std::find(caches.begin(), caches.end(), tc));
+    }
+    delete tc;
+}
+
+SecurePool::ThreadCacheOwner::~ThreadCacheOwner()
+{
+    tls_exited = true;
+    if (cache)
+        SecurePool::instance().retire_thread_cache(cache);
+    cache = nullptr;
+}
+
+char *SecurePool::allocate(size_t n)
+{
+    const size_t idx = class_index(n);
+    FreeBlock *b;
+    if (ThreadCache *tc = thread_cache()){
+        ThreadCache::Magazine &mag = tc->magazines[idx];
+        if (mag.count == 0 && refill_magazine(mag, idx)){
+            bump(tc->misses);
+        } else {
+            bump(tc->hits);
+        }
+        b = mag.blocks[--mag.count];
+    } else {
+        b = reinterpret_cast<FreeBlock *>(allocate_shared(idx));
+    }
+
+    // The rest of the block was wiped on release (or is fresh slab memory);
+    // only the free-list link needs clearing.
+    b->next = nullptr;
+    return reinterpret_cast<char *>(b);
+}
+
+void SecurePool::release(char *p, size_t n) noexcept
+{
+    if (!p)
+        return;
+    const size_t idx = class_index(n);
+    FreeBlock *b = reinterpret_cast<FreeBlock *>(p);
+    if (ThreadCache *tc = thread_cache()){
+        ThreadCache::Magazine &mag = tc->magazines[idx];
+        if (mag.count == MagazineSize)
+            flush_magazine(mag, idx, MagazineSize / 2);
+        mag.blocks[mag.count++] = b;
+        bump(tc->releases);
+        return;
+    }
+    release_shared(idx, b);
+}
+
+SecurePool::Stats SecurePool::stats() const noexcept
+{
+    Stats total{0, 0, 0};
+    for (const SizeClass &sc : classes){
+        std::lock_guard<std::mutex> guard(sc.lock);
+        total.hits += sc.hits;
+        total.misses += sc.misses;
+        total.releases += sc.releases;
+    }
+    std::lock_guard<std::mutex> guard(caches_lock);
+    total.hits += retired_hits;
+    total.misses += retired_misses;
+    total.releases += retired_releases;
+    for (const ThreadCache *tc : caches){
+        total.hits += tc->hits.load(std::memory_order_relaxed);
+        total.misses += tc->misses.load(std::memory_order_relaxed);
+        total.releases += tc->releases.load(std::memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,58 @@
+#include "include/SecureSpan.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+namespace secureview_debug
+{
+namespace
+{
+    struct Registry
+    {
+        std::mutex lock;
+        std::unordered_map<const void *, uint64_t> live;
+        uint64_t next_generation = 1;
+    };
+
+    // Never destroyed, so buffers with static storage duration can detach
+    // during exit.
+    Registry &registry() noexcept
+    {
+        static Registry *r = new Registry();
+        return *r;
+    }
+}
+
+// (Re)registers `owner` under a fresh generation, invalidating older views.
+void attach(const void *owner) noexcept
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    r.live[owner] = r.next_generation++;
+}
+
+void detach(const void *owner) noexcept
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    r.live.erase(owner);
+}
+
+uint64_t generation(const void *owner) noexcept
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    auto it = r.live.find(owner);
+    return it == r.live.end() ? 0 : it->second;
+}
+
+// Aborts if the buffer a view was made from is gone or has moved its storage.
+void check(const void *owner, uint64_t gen) noexcept
+{
+    if (generation(owner) != gen){
+        std::fprintf(stderr, "SecureSpan: view outlived its SecureBuffer (or its storage moved)\n");
+        std::abort();
+    }
+}
+}
@@ -0,0 +1,244 @@
+#include "include/SecureWipe.hpp"
+#include "include/NonTemporal.hpp"
+#include <atomic>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SECUREWIPE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace securewipe
+{
+namespace
+{
+    using WipeFn = void (*)(void *, size_t) noexcept;
+
+    // Compiler barrier: tells the optimizer that the memory behind `ptr` may be
+    // read after the wipe, so the preceding stores can never be treated as dead
+    // and removed (for example right before `delete[]`).
+    inline void escape(void *ptr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
+        (void)ptr;
+#endif
+    }
+
+    // The original byte-at-a-time loop. Kept as the portable fallback, for the
+    // short head/tail of vector kernels and as the benchmark baseline.
+    void wipe_scalar(void *ptr, size_t len) noexcept
+    {
+        volatile char *p = reinterpret_cast<volatile char *>(ptr);
+        while (len--){
+            *p++ = 0;
+        }
+    }
+
+#ifdef SECUREWIPE_X86
+    // Each vector kernel follows the same shape:
+    //   1. buffers shorter than one vector go through the scalar loop;
+    //   2. one unaligned store covers the head;
+    //   3. aligned stores (unrolled x4) cover the body;
+    //   4. one unaligned store ending at the last byte covers the tail.
+    // Head and tail stores may overlap the body, which is harmless for zeroing.
+
+    __attribute__((target("sse2"))) void wipe_sse2(void *ptr, size_t len) noexcept
+    {
+        constexpr size_t W = 16;
+        char *p = static_cast<char *>(ptr);
+        if (len < W){
+            wipe_scalar(ptr, len);
+            return;
+        }
+        const __m128i zero = _mm_setzero_si128();
+        char *end = p + len;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), zero);
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + W) & ~uintptr_t(W - 1));
+        for (; a + 4 * W <= end; a += 4 * W){
+            _mm_store_si128(reinterpret_cast<__m128i *>(a), zero);
+            _mm_store_si128(reinterpret_cast<__m128i *>(a + W), zero);
+            _mm_store_si128(reinterpret_cast<__m128i *>(a + 2 * W), zero);
+            _mm_store_si128(reinterpret_cast<__m128i *>(a + 3 * W), zero);
+        }
+        for (; a + W <= end; a += W){
+            _mm_store_si128(reinterpret_cast<__m128i *>(a), zero);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(end - W), zero);
+        escape(ptr);
+    }
+
+    __attribute__((target("avx2"))) void wipe_avx2(void *ptr, size_t len) noexcept
+    {
+        constexpr size_t W = 32;
+        char *p = static_cast<char *>(ptr);
+        if (len < W){
+            wipe_sse2(ptr, len);
+            return;
+        }
+        const __m256i zero = _mm256_setzero_si256();
+        char *end = p + len;
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), zero);
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + W) & ~uintptr_t(W - 1));
+        for (; a + 4 * W <= end; a += 4 * W){
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a), zero);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a + W), zero);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a + 2 * W), zero);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a + 3 * W), zero);
+        }
+        for (; a + W <= end; a += W){
+            _mm256_store_si256(reinterpret_cast<__m256i *>(a), zero);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(end - W), zero);
+        escape(ptr);
+    }
+
+    __attribute__((target("avx512f"))) void wipe_avx512(void *ptr, size_t len) noexcept
+    {
+        constexpr size_t W = 64;
+        char *p = static_cast<char *>(ptr);
+        if (len < W){
+            wipe_avx2(ptr, len);
+            return;
+        }
+        const __m512i zero = _mm512_setzero_si512();
+        char *end = p + len;
+        _mm512_storeu_si512(p, zero);
+        char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + W) & ~uintptr_t(W - 1));
+        for (; a + 4 * W <= end; a += 4 * W){
+            _mm512_store_si512(a, zero);
+            _mm512_store_si512(a + W, zero);
+            _mm512_store_si512(a + 2 * W, zero);
+            _mm512_store_si512(a + 3 * W, zero);
+        }
+        for (; a + W <= end; a += W){
+            _mm512_store_si512(a, zero);
+        }
+        _mm512_storeu_si512(end - W, zero);
+        escape(ptr);
+    }
+#endif // SECUREWIPE_X86
+
+    WipeFn kernel_fn(Kernel k) noexcept
+    {
+        switch (k){
+#ifdef SECUREWIPE_X86
+        case Kernel::SSE2:
+            return wipe_sse2;
+        case Kernel::AVX2:
+            return wipe_avx2;
+        case Kernel::AVX512:
+            return wipe_avx512;
+#endif
+        default:
+            return wipe_scalar;
+        }
+    }
+
+    Kernel select_kernel() noexcept
+    {
+        if (is_supported(Kernel::AVX512))
+            return Kernel::AVX512;
+        if (is_supported(Kernel::AVX2))
+            return Kernel::AVX2;
+        if (is_supported(Kernel::SSE2))
+            return Kernel::SSE2;
+        return Kernel::Scalar;
+    }
+
+    void wipe_resolve(void *ptr, size_t len) noexcept;
+
+    // Starts out pointing at the resolver, which is constant-initialized, so
+    // the pointer is valid even for wipes issued from static constructors or
+    // destructors in other translation units.
+    std::atomic<WipeFn> active_fn{wipe_resolve};
+    std::atomic<Kernel> bound_kernel{Kernel::Scalar};
+
+    // Runs CPUID, records the chosen kernel for `active_kernel()` and points
+    // `active_fn` at it. Concurrent first calls are benign since every thread
+    // computes and stores the same values.
+    WipeFn bind_kernel() noexcept
+    {
+        const Kernel k = select_kernel();
+        bound_kernel.store(k, std::memory_order_relaxed);
+        WipeFn fn = kernel_fn(k);
+        active_fn.store(fn, std::memory_order_release);
+        return fn;
+    }
+
+    // First-call trampoline: binds the kernel once and forwards the current
+    // call to it.
+    void wipe_resolve(void *ptr, size_t len) noexcept
+    {
+        bind_kernel()(ptr, len);
+    }
+}
+
+void wipe(void *ptr, size_t len) noexcept
+{
+    if (!ptr || len == 0)
+        return;
+    // Large wipes would only evict the caller's working set from the cache;
+    // stream them straight to memory instead.
+    if (len >= nontemporal::threshold()){
+        nontemporal::zero(ptr, len);
+        return;
+    }
+    active_fn.load(std::memory_order_relaxed)(ptr, len);
+}
+
+void wipe_with(Kernel k, void *ptr, size_t len) noexcept
+{
+    if (!ptr || len == 0)
+        return;
+    kernel_fn(is_supported(k) ? k : Kernel::Scalar)(ptr, len);
+}
+
+bool is_supported(Kernel k) noexcept
+{
+    switch (k){
+    case Kernel::Scalar:
+        return true;
+#ifdef SECUREWIPE_X86
+    // __builtin_cpu_supports also checks (via XGETBV) that the OS saves the
+    // wider register state, so AVX kernels are never picked when unusable.
+    case Kernel::SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+    case Kernel::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    case Kernel::AVX512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+// Reports the kernel `wipe` is bound to, binding it first if nothing has
+// been wiped yet.
+Kernel active_kernel() noexcept
+{
+    if (active_fn.load(std::memory_order_acquire) == wipe_resolve)
+        bind_kernel();
+    return bound_kernel.load(std::memory_order_relaxed);
+}
+
+const char *kernel_name(Kernel k) noexcept
+{
+    switch (k){
+    case Kernel::Scalar:
+        return "scalar";
+    case Kernel::SSE2:
+        return "sse2";
+    case Kernel::AVX2:
+        return "avx2";
+    case Kernel::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+}
@@ -0,0 +1,44 @@
+#include "include/SecureWipingResource.hpp"
+#include "include/SecureWipe.hpp"
+
+SecureWipingResource::SecureWipingResource(std::pmr::memory_resource *upstream, BufferWipe buffer_wipe) noexcept
+    : upstream(upstream), wipe_mode(buffer_wipe)
+{
+}
+
+std::pmr::memory_resource *SecureWipingResource::upstream_resource() const noexcept
+{
+    return upstream;
+}
+
+SecureWipingResource::BufferWipe SecureWipingResource::buffer_wipe() const noexcept
+{
+    return wipe_mode;
+}
+
+// A monotonic arena only reuses memory after `release()`, which returns every
+// chunk to its upstream, so a wiping upstream covers all of it.
+bool SecureWipingResource::wipes_buffers(const std::pmr::memory_resource *mr) noexcept
+{
+    if (auto *arena = dynamic_cast<const std::pmr::monotonic_buffer_resource *>(mr))
+        mr = arena->upstream_resource();
+    auto *wiping = dynamic_cast<const SecureWipingResource *>(mr);
+    return wiping && wiping->wipe_mode == BufferWipe::OnRelease;
+}
+
+void *SecureWipingResource::do_allocate(size_t bytes, size_t alignment)
+{
+    return upstream->allocate(bytes, alignment);
+}
+
+// Wipes the whole block with the vectorized kernel, then frees it upstream.
+void SecureWipingResource::do_deallocate(void *p, size_t bytes, size_t alignment)
+{
+    securewipe::wipe(p, bytes);
+    upstream->deallocate(p, bytes, alignment);
+}
+
+bool SecureWipingResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
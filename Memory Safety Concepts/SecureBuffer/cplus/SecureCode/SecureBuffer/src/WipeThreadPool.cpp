@@ -0,0 +1,127 @@
+#include "include/WipeThreadPool.hpp"
+#include "include/NonTemporal.hpp"
+#include "include/PageAllocator.hpp"
+#include "include/SecureWipe.hpp"
+#include <algorithm>
+
+WipeThreadPool::WipeThreadPool(size_t n)
+{
+    threads.reserve(n);
+    try {
+        for (size_t i = 0; i < n; ++i){
+            threads.emplace_back([this] { run(); });
+        }
+    } catch (...) {
+        // Destroying a joinable std::thread terminates the process, so the
+        // threads that did start are stopped before the error propagates.
+        stop();
+        throw;
+    }
+}
+
+WipeThreadPool::~WipeThreadPool()
+{
+    stop();
+}
+
+// Tells every pool thread to exit and waits for them.
+void WipeThreadPool::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &t : threads){
+        t.join();
+    }
+}
+
+WipeThreadPool &WipeThreadPool::instance()
+{
+    static WipeThreadPool *pool = [] {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return new WipeThreadPool(hw > 1 ? hw - 1 : 0);
+    }();
+    return *pool;
+}
+
+size_t WipeThreadPool::thread_count() const noexcept
+{
+    return threads.size();
+}
+
+// Claims and wipes chunks until none are left. Chunk `i` covers
+// [base + i * chunk, base + (i + 1) * chunk) clipped to [begin, end), so
+// every boundary between chunks falls on a page boundary and no two
+// threads ever write to the same page.
+void WipeThreadPool::work() noexcept
+{
+    size_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < chunks){
+        char *lo = std::max(begin, base + i * chunk);
+        char *hi = std::min(end, base + (i + 1) * chunk);
+        if (streaming)
+            nontemporal::zero(lo, hi - lo);
+        else
+            securewipe::wipe(lo, hi - lo);
+        if (done.fetch_add(1, std::memory_order_release) + 1 == chunks)
+            done.notify_all();
+    }
+}
+
+void WipeThreadPool::run() noexcept
+{
+    uint64_t seen = 0;
+    for (;;){
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            ++active;
+        }
+        work();
+        std::lock_guard<std::mutex> guard(lock);
+        if (--active == 0)
+            idle.notify_all();
+    }
+}
+
+void WipeThreadPool::wipe(void *ptr, size_t len) noexcept
+{
+    if (threads.empty() || len < MinParallelBytes){
+        securewipe::wipe(ptr, len);
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial(submit_lock);
+    const size_t page = pagealloc::page_size();
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        idle.wait(guard, [&] { return active == 0; });
+        begin = static_cast<char *>(ptr);
+        end = begin + len;
+        base = begin - reinterpret_cast<uintptr_t>(begin) % page;
+        // About four chunks per participant balances uneven progress
+        // without making chunks so small that claiming them dominates.
+        const size_t span = end - base;
+        const size_t target = span / ((threads.size() + 1) * 4);
+        chunk = std::max(page, (target + page - 1) / page * page);
+        chunks = (span + chunk - 1) / chunk;
+        streaming = len >= nontemporal::threshold();
+        next.store(0, std::memory_order_relaxed);
+        done.store(0, std::memory_order_relaxed);
+        ++generation;
+    }
+    wake.notify_all();
+    work();
+
+    // Acquire pairs with each chunk's release, so all pool stores are
+    // visible to the caller once this returns.
+    size_t n;
+    while ((n = done.load(std::memory_order_acquire)) < chunks){
+        done.wait(n, std::memory_order_acquire);
+    }
+}
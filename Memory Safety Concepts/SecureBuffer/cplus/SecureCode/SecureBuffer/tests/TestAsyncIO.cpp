@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "include/AsyncIO.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+// Runs every test against both backends (io_uring only where available).
+class AsyncIOTest : public ::testing::TestWithParam<AsyncIO::Backend> {
+protected:
+    void SetUp() override {
+        if (GetParam() == AsyncIO::Backend::IoUring && !AsyncIO::io_uring_supported())
+            GTEST_SKIP() << "io_uring unavailable";
+        fd = memfd_create("asyncio-test", MFD_CLOEXEC);
+        ASSERT_GE(fd, 0);
+    }
+    void TearDown() override {
+        if (fd >= 0)
+            close(fd);
+    }
+    int fd = -1;
+};
+
+static std::vector<SecureBuffer> make_keys(size_t count, size_t bytes) {
+    std::vector<SecureBuffer> keys;
+    for (size_t i = 0; i < count; ++i)
+        keys.emplace_back(bytes);
+    return keys;
+}
+
+// Test: a batch of writes followed by a batch of reads round-trips the data,
+// with more operations than the queue depth
+TEST_P(AsyncIOTest, RoundTripsBatches) {
+    constexpr size_t Keys = 100, Bytes = 48;
+    AsyncIO io(8, GetParam());
+    EXPECT_EQ(io.backend(), GetParam());
+
+    auto out = make_keys(Keys, Bytes);
+    for (size_t i = 0; i < Keys; ++i)
+        std::memset(out[i].data_ptr(), static_cast<int>(i + 1), Bytes);
+    size_t written = 0;
+    for (size_t i = 0; i < Keys; ++i) {
+        io.write(fd, out[i], i * Bytes, [&](ssize_t res) {
+            EXPECT_EQ(res, static_cast<ssize_t>(Bytes));
+            ++written;
+        });
+    }
+    io.drain();
+    EXPECT_EQ(written, Keys);
+    EXPECT_EQ(io.pending(), 0u);
+
+    auto in = make_keys(Keys, Bytes);
+    size_t read = 0;
+    for (size_t i = 0; i < Keys; ++i) {
+        io.read(fd, in[i], i * Bytes, [&](ssize_t res) {
+            EXPECT_EQ(res, static_cast<ssize_t>(Bytes));
+            ++read;
+        });
+    }
+    io.drain();
+    EXPECT_EQ(read, Keys);
+    for (size_t i = 0; i < Keys; ++i)
+        EXPECT_TRUE(in[i].constant_time_equal(out[i])) << "key " << i;
+}
+
+// Test: fixed buffers carry the same data; other buffers still work
+TEST_P(AsyncIOTest, FixedBuffers) {
+    AsyncIO io(16, GetParam());
+    auto keys = make_keys(4, 4096);
+    const bool registered = io.register_buffers(keys);
+    EXPECT_EQ(registered, GetParam() == AsyncIO::Backend::IoUring);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::memset(keys[i].data_ptr(), 'a' + static_cast<int>(i), 4096);
+        io.write(fd, keys[i], i * 4096, nullptr);
+    }
+    SecureBuffer unregistered(4096);
+    std::memset(unregistered.data_ptr(), 'z', 4096);
+    io.write(fd, unregistered, 4 * 4096, nullptr);
+    io.drain();
+
+    for (SecureBuffer &k : keys)
+        std::memset(k.data_ptr(), 0, 4096);
+    ssize_t results[4] = {};
+    for (size_t i = 0; i < keys.size(); ++i)
+        io.read(fd, keys[i], i * 4096, [&results, i](ssize_t res) { results[i] = res; });
+    EXPECT_EQ(io.wait(keys.size()), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(results[i], 4096);
+        EXPECT_EQ(keys[i].data_ptr()[4095], 'a' + static_cast<int>(i));
+    }
+    io.unregister_buffers();
+}
+
+// Test: a large mapped buffer is not pinned, so reads still land in it after
+// a shrink has discarded its pages and a resize has faulted in new ones
+TEST_P(AsyncIOTest, DiscardableBuffersAreNotPinned) {
+    constexpr size_t Bytes = 2 << 20;
+    std::vector<char> payload(Bytes, 'k');
+    ASSERT_EQ(pwrite(fd, payload.data(), Bytes, 0), static_cast<ssize_t>(Bytes));
+
+    AsyncIO io(4, GetParam());
+    std::vector<SecureBuffer> bufs;
+    bufs.emplace_back(Bytes, SecureBuffer::Storage::Mapped);
+    SecureBuffer &buf = bufs[0];
+    EXPECT_TRUE(buf.discards_pages());
+    EXPECT_FALSE(io.register_buffers(bufs));
+    buf.resize(0);
+    buf.resize(Bytes);
+
+    ssize_t result = 0;
+    io.read(fd, buf, 0, [&](ssize_t res) { result = res; });
+    io.drain();
+    EXPECT_EQ(result, static_cast<ssize_t>(Bytes));
+    EXPECT_TRUE(buf.constant_time_equal(payload.data(), Bytes));
+}
+
+// Test: failures reach the callback as -errno; reads past the end are short
+TEST_P(AsyncIOTest, ReportsErrorsAndShortReads) {
+    AsyncIO io(4, GetParam());
+    SecureBuffer key(64);
+    ssize_t bad = 0, past_end = -1;
+    io.read(-1, key, 0, [&](ssize_t res) { bad = res; });
+    io.read(fd, key, 1 << 20, [&](ssize_t res) { past_end = res; });
+    io.drain();
+    EXPECT_EQ(bad, -EBADF);
+    EXPECT_EQ(past_end, 0);
+}
+
+// Test: callbacks may chain follow-up operations
+TEST_P(AsyncIOTest, CallbacksQueueFollowUps) {
+    AsyncIO io(2, GetParam());
+    SecureBuffer key(16);
+    std::memcpy(key.data_ptr(), "chained-write-ok", 16);
+    SecureBuffer back(16);
+    bool done = false;
+    io.write(fd, key, 0, [&](ssize_t) {
+        io.read(fd, back, 0, [&](ssize_t res) { done = res == 16; });
+    });
+    io.drain();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(std::memcmp(back.data_ptr(), "chained-write-ok", 16), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncIOTest,
+                         ::testing::Values(AsyncIO::Backend::IoUring, AsyncIO::Backend::Threads),
+                         [](const auto &info) {
+                             return info.param == AsyncIO::Backend::IoUring ? "IoUring" : "Threads";
+                         });
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "include/ConstantTime.hpp"
+#include "include/SecureBuffer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using consttime::Kernel;
+
+static const Kernel kAllKernels[] = {Kernel::Scalar, Kernel::SSE2, Kernel::AVX2};
+
+// Test: every kernel finds a single flipped bit at any position, for lengths
+// around the vector widths and unaligned starts
+TEST(ConstantTimeTest, KernelsDetectEveryDifference) {
+    const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 127, 128, 129, 1000};
+    for (Kernel k : kAllKernels) {
+        if (!consttime::is_supported(k))
+            continue;
+        for (size_t len : lengths) {
+            for (size_t offset : {0, 1, 7}) {
+                std::vector<unsigned char> a(len + 8), b(len + 8);
+                for (size_t i = 0; i < a.size(); ++i) {
+                    a[i] = b[i] = static_cast<unsigned char>(i * 31 + 7);
+                }
+                ASSERT_TRUE(consttime::equal_with(k, a.data() + offset, b.data() + offset, len));
+                for (size_t pos = 0; pos < len; ++pos) {
+                    b[offset + pos] ^= 0x80;
+                    ASSERT_FALSE(consttime::equal_with(k, a.data() + offset, b.data() + offset, len))
+                        << consttime::kernel_name(k) << " len=" << len << " pos=" << pos;
+                    b[offset + pos] ^= 0x80;
+                }
+            }
+        }
+    }
+}
+
+// Test: active_kernel reports the kernel bound on first use, without
+// re-running the selection
+TEST(ConstantTimeTest, ActiveKernelIsTheBoundOne) {
+    const Kernel k = consttime::active_kernel();
+    EXPECT_TRUE(consttime::is_supported(k));
+    EXPECT_TRUE(consttime::equal("same", "same", 4));
+    EXPECT_EQ(consttime::active_kernel(), k);
+}
+
+// Test: SecureBuffer comparison, including size mismatches
+TEST(ConstantTimeTest, SecureBufferEqual) {
+    SecureBuffer a(0, SecureBuffer::Storage::Heap), b(0, SecureBuffer::Storage::Heap);
+    a.append("mac-0123456789abcdef", 20);
+    b.append("mac-0123456789abcdef", 20);
+    EXPECT_TRUE(a.constant_time_equal(b));
+    EXPECT_TRUE(a.constant_time_equal("mac-0123456789abcdef", 20));
+    EXPECT_FALSE(a.constant_time_equal("mac-0123456789abcdeF", 20));
+    EXPECT_FALSE(a.constant_time_equal("mac-0123456789abcde", 19));
+    b.data_ptr()[0] = 'M';
+    EXPECT_FALSE(a.constant_time_equal(b));
+}
+
+// Timing-variance harness (dudect style): times `cmp` on two input classes,
+// "equal" and "differs in the first byte", interleaved in random order,
+// crops the slowest 10% of samples and returns Welch's t statistic between
+// the classes. |t| beyond ~4.5 indicates a data-dependent running time.
+template <typename Compare>
+static double timing_t_statistic(Compare cmp, size_t len, size_t samples)
+{
+    // One probe buffer whose first byte is set per sample, so both classes
+    // read the same addresses and only the contents differ.
+    std::vector<unsigned char> secret(len, 0x5A), probe(len, 0x5A);
+    std::mt19937 rng(12345);
+    std::vector<double> times[2];
+    volatile bool sink = false;
+    for (size_t i = 0; i < samples; ++i) {
+        const int cls = rng() & 1;
+        probe[0] = static_cast<unsigned char>(0x5A ^ cls);
+        const auto start = std::chrono::steady_clock::now();
+        sink = cmp(secret.data(), probe.data(), len);
+        const auto stop = std::chrono::steady_clock::now();
+        times[cls].push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    (void)sink;
+
+    double mean[2], var[2];
+    for (int c = 0; c < 2; ++c) {
+        std::vector<double> &t = times[c];
+        std::sort(t.begin(), t.end());
+        t.resize(t.size() * 9 / 10);
+        double sum = 0, sq = 0;
+        for (double x : t) {
+            sum += x;
+            sq += x * x;
+        }
+        mean[c] = sum / t.size();
+        var[c] = sq / t.size() - mean[c] * mean[c];
+    }
+    return (mean[0] - mean[1]) /
+           std::sqrt(var[0] / times[0].size() + var[1] / times[1].size());
+}
+
+// Test: the harness flags memcmp's early exit, and the constant-time
+// comparison shows no comparable difference between the classes.
+// Disabled by default: its outcome depends on host noise, so it is a
+// measurement rather than a regression test. Run it with `make timing`.
+TEST(ConstantTimeTest, DISABLED_TimingDoesNotDependOnContents) {
+    constexpr size_t Len = 16 * 1024;
+    constexpr size_t Samples = 20000;
+    const double leaky = timing_t_statistic(
+        [](const void *a, const void *b, size_t n) { return std::memcmp(a, b, n) == 0; }, Len, Samples);
+    EXPECT_GT(std::fabs(leaky), 20.0);
+
+    const double t = timing_t_statistic(
+        [](const void *a, const void *b, size_t n) { return consttime::equal(a, b, n); }, Len, Samples);
+    // Generous bound: system noise on shared hosts inflates |t| somewhat, an
+    // early exit inflates it by orders of magnitude (see `leaky`).
+    EXPECT_LT(std::fabs(t), 10.0) << "memcmp t=" << leaky;
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "include/DeferredWiper.hpp"
+#include <atomic>
+#include <cstring>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Resource that records which thread returned each block and whether the
+// block had been wiped
+class WatchingResource : public std::pmr::memory_resource {
+public:
+    std::atomic<int> dirty{0};
+    std::atomic<int> freed{0};
+    std::atomic<int> freed_elsewhere{0};
+    std::thread::id owner = std::this_thread::get_id();
+
+private:
+    void *do_allocate(size_t bytes, size_t align) override {
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t align) override {
+        const char *c = static_cast<const char *>(p);
+        for (size_t i = 0; i < bytes; ++i) {
+            if (c[i]) {
+                ++dirty;
+                break;
+            }
+        }
+        if (std::this_thread::get_id() != owner)
+            ++freed_elsewhere;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        ++freed;
+    }
+    bool do_is_equal(const std::pmr::memory_resource &o) const noexcept override {
+        return this == &o;
+    }
+};
+
+// Test: large buffers are handed to the wiper thread; flush waits for them
+TEST(DeferredWiperTest, LargeBuffersWipedInBackground) {
+    DeferredWiper &wiper = DeferredWiper::instance();
+    wiper.enable(4096);
+    const DeferredWiper::Stats before = wiper.stats();
+    {
+        SecureBuffer big(1 << 20, SecureBuffer::Storage::Heap);
+        std::memset(big.data_ptr(), 0x33, big.size_bytes());
+        SecureBuffer small(1000, SecureBuffer::Storage::Heap);
+        std::memset(small.data_ptr(), 0x33, small.size_bytes());
+    }
+    wiper.flush();
+    wiper.disable();
+
+    const DeferredWiper::Stats after = wiper.stats();
+    EXPECT_EQ(after.deferred - before.deferred, 1u); // only the large one
+    EXPECT_EQ(after.fallbacks, before.fallbacks);
+}
+
+// Test: buffers in caller-owned memory are wiped and returned on the
+// destroying thread, never after the caller may have released the resource
+TEST(DeferredWiperTest, ResourceBuffersAreNeverDeferred) {
+    DeferredWiper &wiper = DeferredWiper::instance();
+    wiper.enable(4096);
+    const DeferredWiper::Stats before = wiper.stats();
+    WatchingResource res;
+    {
+        SecureBuffer big(1 << 20, &res);
+        std::memset(big.data_ptr(), 0x33, big.size_bytes());
+    }
+    // Already back in the resource, without a flush.
+    EXPECT_EQ(res.freed.load(), 1);
+    EXPECT_EQ(res.freed_elsewhere.load(), 0);
+    EXPECT_EQ(res.dirty.load(), 0);
+    wiper.disable();
+    EXPECT_EQ(wiper.stats().deferred, before.deferred);
+}
+
+// Test: disabled by default, and disabling restores synchronous wiping
+TEST(DeferredWiperTest, DisabledIsSynchronous) {
+    DeferredWiper &wiper = DeferredWiper::instance();
+    EXPECT_FALSE(wiper.enabled());
+    WatchingResource res;
+    {
+        SecureBuffer big(1 << 20, &res);
+        std::memset(big.data_ptr(), 0x44, big.size_bytes());
+    }
+    EXPECT_EQ(res.freed.load(), 1);
+    EXPECT_EQ(res.freed_elsewhere.load(), 0);
+    EXPECT_EQ(res.dirty.load(), 0);
+}
+
+// Test: once disable() returns, no buffer destroyed concurrently is still on
+// its way into the queue (the shutdown barrier holds under races)
+TEST(DeferredWiperTest, DisableWaitsForRacingDestroyers) {
+    DeferredWiper &wiper = DeferredWiper::instance();
+    std::atomic<bool> stop{false};
+    std::thread destroyer([&] {
+        while (!stop.load()) {
+            SecureBuffer b(64 * 1024, SecureBuffer::Storage::Heap);
+            b.data_ptr()[0] = 0x66;
+        }
+    });
+    int late = 0;
+    for (int round = 0; round < 200; ++round) {
+        wiper.enable(4096);
+        std::this_thread::yield();
+        wiper.disable();
+        const uint64_t settled = wiper.stats().deferred;
+        std::this_thread::yield();
+        if (wiper.stats().deferred != settled)
+            ++late;
+    }
+    stop.store(true);
+    destroyer.join();
+    EXPECT_EQ(late, 0);
+    EXPECT_FALSE(wiper.enabled());
+}
+
+// Test: a fork()ed child, which has no wiper thread, wipes synchronously and
+// can start its own thread; flush() never hangs there
+TEST(DeferredWiperTest, ForkedChildWipesSynchronously) {
+    DeferredWiper &wiper = DeferredWiper::instance();
+    wiper.enable(1 << 20);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        alarm(10); // a hang fails the test instead of stalling the suite
+        const DeferredWiper::Stats before = wiper.stats();
+        if (wiper.enabled())
+            _exit(1);
+        {
+            SecureBuffer big(4 << 20, SecureBuffer::Storage::Heap);
+            std::memset(big.data_ptr(), 0x77, big.size_bytes());
+        }
+        wiper.flush();
+        if (wiper.stats().deferred != before.deferred)
+            _exit(2);
+        wiper.enable(1 << 20);
+        {
+            SecureBuffer big(4 << 20, SecureBuffer::Storage::Heap);
+            std::memset(big.data_ptr(), 0x77, big.size_bytes());
+        }
+        wiper.disable();
+        _exit(wiper.stats().deferred == before.deferred + 1 ? 0 : 3);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status)) << "child killed by signal " << WTERMSIG(status);
+    EXPECT_EQ(WIFEXITED(status) ? WEXITSTATUS(status) : -1, 0);
+    EXPECT_TRUE(wiper.enabled());
+    wiper.disable();
+}
+
+// Test: concurrent destroyers all get their buffers wiped, whether queued or
+// wiped inline because the queue was full
+TEST(DeferredWiperTest, ManyConcurrentDefersAllComplete) {
+    DeferredWiper &wiper = DeferredWiper::instance();
+    wiper.enable(4096);
+    const DeferredWiper::Stats before = wiper.stats();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                SecureBuffer b(64 * 1024, SecureBuffer::Storage::Heap);
+                std::memset(b.data_ptr(), 0x55, b.size_bytes());
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    wiper.flush();
+    wiper.disable();
+    const DeferredWiper::Stats after = wiper.stats();
+    EXPECT_EQ((after.deferred - before.deferred) + (after.fallbacks - before.fallbacks), 400u);
+}
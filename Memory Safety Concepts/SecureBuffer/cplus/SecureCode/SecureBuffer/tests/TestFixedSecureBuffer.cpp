@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "include/FixedSecureBuffer.hpp"
+#include <cstring>
+
+// Generic helper accepting both SecureBuffer and FixedSecureBuffer<N>
+template <SecureBytes Buffer>
+static size_t count_nonzero(const Buffer &buf) {
+    size_t n = 0;
+    for (size_t i = 0; i < buf.size_bytes(); ++i) {
+        n += buf.data_ptr()[i] != 0;
+    }
+    return n;
+}
+
+// Test: size is a compile-time constant and there is no heap storage
+TEST(FixedSecureBufferTest, SizeIsCompileTime) {
+    static_assert(Aes256Key::capacity() == 32);
+    static_assert(sizeof(GcmNonce) <= 16);
+    constexpr size_t n = [] { Aes128Key k; return k.size_bytes(); }();
+    EXPECT_EQ(n, 16u);
+}
+
+// Test: buffer starts zeroed and is usable through the shared interface
+TEST(FixedSecureBufferTest, ZeroedAndGeneric) {
+    Aes256Key key;
+    SecureBuffer dyn(32);
+    EXPECT_EQ(count_nonzero(key), 0u);
+    EXPECT_EQ(count_nonzero(dyn), 0u);
+
+    std::memcpy(key.data_ptr(), "0123456789abcdef", 16);
+    EXPECT_EQ(count_nonzero(key), 16u);
+}
+
+// Test: moving copies the bytes and wipes the source
+TEST(FixedSecureBufferTest, MoveWipesSource) {
+    GcmNonce a;
+    std::memcpy(a.data_ptr(), "nonce-12byte", 12);
+
+    GcmNonce b = std::move(a);
+    EXPECT_EQ(std::memcmp(b.data_ptr(), "nonce-12byte", 12), 0);
+    EXPECT_EQ(count_nonzero(a), 0u);
+
+    GcmNonce c;
+    c = std::move(b);
+    EXPECT_EQ(std::memcmp(c.data_ptr(), "nonce-12byte", 12), 0);
+    EXPECT_EQ(count_nonzero(b), 0u);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "include/ForkRepopulator.hpp"
+#include "include/LockedArena.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs `child` in a forked process and returns its exit status (0 = pass).
+template <typename Child>
+static int run_in_child(Child child) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+        _exit(child());
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 100;
+}
+
+static bool all_zero(const SecureBuffer &buf) {
+    for (size_t i = 0; i < buf.size_bytes(); ++i) {
+        if (buf.data_ptr()[i] != 0)
+            return false;
+    }
+    return true;
+}
+
+// Test: small and large wipe-on-fork buffers read as zero in the child and
+// keep their contents in the parent
+TEST(ForkRepopulatorTest, ChildSeesZeroPages) {
+    SecureBuffer key(32, SecureBuffer::Storage::WipeOnFork);
+    SecureBuffer table(1 << 20, SecureBuffer::Storage::WipeOnFork);
+    if (key.storage() != SecureBuffer::Storage::WipeOnFork ||
+        table.storage() != SecureBuffer::Storage::WipeOnFork) {
+        GTEST_SKIP() << "MADV_WIPEONFORK unavailable";
+    }
+    std::memset(key.data_ptr(), 0x5A, key.size_bytes());
+    std::memset(table.data_ptr(), 0xA5, table.size_bytes());
+
+    EXPECT_EQ(run_in_child([&] {
+        if (!all_zero(key) || !all_zero(table))
+            return 1;
+        if (key.size_bytes() != 32 || table.size_bytes() != (1u << 20))
+            return 2;
+        // The storage still works in the child.
+        key.append("more", 4);
+        return std::memcmp(key.data_ptr() + 32, "more", 4) == 0 ? 0 : 3;
+    }), 0);
+
+    EXPECT_EQ(static_cast<unsigned char>(key.data_ptr()[0]), 0x5A);
+    EXPECT_EQ(static_cast<unsigned char>(table.data_ptr()[table.size_bytes() - 1]), 0xA5);
+}
+
+// Test: once the locked arena cannot serve a small buffer, it still gets
+// wipe-on-fork pages (its own mapping) rather than plain locked or heap memory
+TEST(ForkRepopulatorTest, SmallBufferFallbackStaysWipeOnFork) {
+    SecureBuffer probe(32, SecureBuffer::Storage::WipeOnFork);
+    if (probe.storage() != SecureBuffer::Storage::WipeOnFork) {
+        GTEST_SKIP() << "MADV_WIPEONFORK unavailable";
+    }
+    // Take what is left of the shared locked budget, then use up the fork
+    // arena's current region until a buffer has to come from elsewhere.
+    LockedArena::Budget &budget = LockedArena::shared_budget();
+    const size_t taken = budget.reserve(1, SIZE_MAX, 1);
+    LockedArena &arena = LockedArena::fork_instance();
+    std::vector<SecureBuffer> held;
+    bool fell_back = false;
+    const size_t blocks = arena.stats().locked_bytes / LockedArena::MaxBlock;
+    for (size_t i = 0; i <= blocks && !fell_back; ++i) {
+        const uint64_t before = arena.stats().allocations;
+        held.emplace_back(LockedArena::MaxBlock, SecureBuffer::Storage::WipeOnFork);
+        fell_back = arena.stats().allocations == before;
+    }
+    ASSERT_TRUE(fell_back);
+    SecureBuffer &key = held.back();
+    EXPECT_EQ(key.storage(), SecureBuffer::Storage::WipeOnFork);
+    std::memset(key.data_ptr(), 0x5A, key.size_bytes());
+
+    EXPECT_EQ(run_in_child([&] { return all_zero(key) ? 0 : 1; }), 0);
+    EXPECT_EQ(static_cast<unsigned char>(key.data_ptr()[0]), 0x5A);
+    held.clear();
+    budget.give_back(taken);
+}
+
+// Test: registered buffers are re-filled in the child, unregistered ones stay zero
+TEST(ForkRepopulatorTest, RepopulatesSelectedBuffers) {
+    SecureBuffer wanted(16, SecureBuffer::Storage::WipeOnFork);
+    SecureBuffer unwanted(16, SecureBuffer::Storage::WipeOnFork);
+    if (wanted.storage() != SecureBuffer::Storage::WipeOnFork) {
+        GTEST_SKIP() << "MADV_WIPEONFORK unavailable";
+    }
+    std::memcpy(wanted.data_ptr(), "parent-secret-01", 16);
+    std::memcpy(unwanted.data_ptr(), "parent-secret-02", 16);
+
+    ForkRepopulator &registry = ForkRepopulator::instance();
+    const uint64_t generation = ForkRepopulator::fork_generation();
+    registry.add(wanted, [](SecureBuffer &buf) { std::memcpy(buf.data_ptr(), "worker-secret-01", 16); });
+
+    EXPECT_EQ(run_in_child([&] {
+        if (ForkRepopulator::fork_generation() != generation + 1)
+            return 1;
+        if (registry.repopulate() != 1)
+            return 2;
+        if (std::memcmp(wanted.data_ptr(), "worker-secret-01", 16) != 0)
+            return 3;
+        return all_zero(unwanted) ? 0 : 4;
+    }), 0);
+
+    EXPECT_EQ(ForkRepopulator::fork_generation(), generation);
+    EXPECT_EQ(std::memcmp(wanted.data_ptr(), "parent-secret-01", 16), 0);
+    registry.forget(wanted);
+    EXPECT_EQ(registry.size(), 0u);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "include/LockedArena.hpp"
+#include "include/SecureBuffer.hpp"
+#include <cstring>
+#include <memory>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+static size_t page_bytes() {
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// Test: many small blocks come out of a single locked region
+TEST(LockedArenaTest, SubAllocatesFromOneRegion) {
+    LockedArena arena(LockedArena::RegionBytes);
+    std::vector<char *> blocks;
+    for (int i = 0; i < 100; ++i) {
+        char *p = arena.allocate(64);
+        if (!p)
+            GTEST_SKIP() << "mlock not permitted in this environment";
+        blocks.push_back(p);
+    }
+    LockedArena::Stats st = arena.stats();
+    EXPECT_EQ(st.regions, 1u);
+    EXPECT_EQ(st.allocations, 100u);
+    for (char *p : blocks) {
+        arena.release(p, 64);
+    }
+}
+
+// Test: released blocks are reused and come back zeroed
+TEST(LockedArenaTest, ReusesWipedBlocks) {
+    LockedArena arena(LockedArena::RegionBytes);
+    char *a = arena.allocate(200);
+    if (!a)
+        GTEST_SKIP() << "mlock not permitted in this environment";
+    std::memset(a, 0, LockedArena::block_size(200));
+    arena.release(a, 200);
+    char *b = arena.allocate(256);
+    EXPECT_EQ(a, b);
+    for (size_t i = 0; i < 256; ++i) {
+        EXPECT_EQ(b[i], 0);
+    }
+    arena.release(b, 256);
+}
+
+// Test: requests beyond the budget are refused instead of over-locking
+TEST(LockedArenaTest, RefusesBeyondBudget) {
+    LockedArena none(0);
+    EXPECT_EQ(none.allocate(64), nullptr);
+    EXPECT_EQ(none.stats().fallbacks, 1u);
+
+    LockedArena one_page(page_bytes());
+    char *p = one_page.allocate(64);
+    if (!p)
+        GTEST_SKIP() << "mlock not permitted in this environment";
+    EXPECT_EQ(one_page.allocate(2 * page_bytes()), nullptr);
+    EXPECT_LE(one_page.stats().locked_bytes, page_bytes());
+    one_page.release(p, 64);
+}
+
+// Test: arenas drawing from one budget lock no more than it allows between
+// them, and a destroyed arena hands its bytes back
+TEST(LockedArenaTest, SharedBudget) {
+    LockedArena::Budget budget(LockedArena::RegionBytes);
+    auto first = std::make_unique<LockedArena>(budget);
+    LockedArena second(budget, LockedArena::Source::WipeOnFork);
+    char *p = first->allocate(64);
+    if (!p)
+        GTEST_SKIP() << "mlock not permitted in this environment";
+    EXPECT_EQ(budget.used(), LockedArena::RegionBytes);
+    EXPECT_EQ(second.allocate(64), nullptr);
+    EXPECT_EQ(second.stats().regions, 0u);
+
+    first->release(p, 64);
+    first.reset();
+    EXPECT_EQ(budget.used(), 0u);
+    char *q = second.allocate(64);
+    ASSERT_NE(q, nullptr);
+    second.release(q, 64);
+
+    EXPECT_EQ(&LockedArena::shared_budget(), &LockedArena::shared_budget());
+}
+
+// Test: reservations never exceed the limit and are rounded to the unit
+TEST(LockedArenaTest, BudgetReservations) {
+    const size_t page = page_bytes();
+    LockedArena::Budget budget(5 * page / 2);
+    EXPECT_EQ(budget.reserve(page, 4 * page, page), 2 * page);
+    EXPECT_EQ(budget.reserve(page, 4 * page, page), 0u);
+    budget.give_back(page);
+    EXPECT_EQ(budget.reserve(2 * page, 4 * page, page), 0u);
+    EXPECT_EQ(budget.reserve(page, 4 * page, page), page);
+    EXPECT_EQ(budget.used(), 2 * page);
+    EXPECT_EQ(budget.limit(), 5 * page / 2);
+}
+
+// Test: an mlock refused over RLIMIT_MEMLOCK does not disable the arena; it
+// maps again once the limit allows it
+TEST(LockedArenaTest, RetriesAfterTransientFailure) {
+    LockedArena arena(page_bytes());
+    struct rlimit saved;
+    ASSERT_EQ(getrlimit(RLIMIT_MEMLOCK, &saved), 0);
+    // A limit below one page makes mlock fail with ENOMEM; a limit of 0
+    // would be EPERM, which the arena rightly treats as permanent.
+    struct rlimit tiny = saved;
+    tiny.rlim_cur = 1;
+    ASSERT_EQ(setrlimit(RLIMIT_MEMLOCK, &tiny), 0);
+    char *p = arena.allocate(64);
+    ASSERT_EQ(setrlimit(RLIMIT_MEMLOCK, &saved), 0);
+    if (p) {
+        arena.release(p, 64);
+        GTEST_SKIP() << "mlock is not bound by RLIMIT_MEMLOCK here (CAP_IPC_LOCK)";
+    }
+    for (unsigned i = 0; i <= LockedArena::RetryInterval && !p; ++i) {
+        p = arena.allocate(64);
+    }
+    EXPECT_NE(p, nullptr);
+    arena.release(p, 64);
+}
+
+// Test: SecureBuffer uses the arena and falls back to the heap when it cannot
+TEST(LockedArenaTest, SecureBufferStorage) {
+    SecureBuffer small(32, SecureBuffer::Storage::Locked);
+    EXPECT_EQ(small.size_bytes(), 32u);
+    if (LockedArena::instance().stats().locked_bytes > 0) {
+        EXPECT_EQ(small.storage(), SecureBuffer::Storage::Locked);
+    }
+    for (size_t i = 0; i < small.size_bytes(); ++i) {
+        EXPECT_EQ(small.data_ptr()[i], 0);
+    }
+
+    SecureBuffer large(LockedArena::MaxBlock + 1, SecureBuffer::Storage::Locked);
+    EXPECT_EQ(large.storage(), SecureBuffer::Storage::Heap);
+}
+
+// Test: a secret arena sub-allocates from memfd_secret regions, or refuses
+// everything when the kernel lacks the syscall
+TEST(LockedArenaTest, SecretRegions) {
+    LockedArena arena(LockedArena::RegionBytes, LockedArena::Source::Secret);
+    EXPECT_EQ(arena.source(), LockedArena::Source::Secret);
+    char *a = arena.allocate(100);
+    if (!LockedArena::secret_supported()) {
+        EXPECT_EQ(a, nullptr);
+        EXPECT_EQ(arena.stats().regions, 0u);
+        return;
+    }
+    if (!a) {
+        GTEST_SKIP() << "memfd_secret refused (RLIMIT_MEMLOCK?)";
+    }
+    std::vector<char *> blocks{a};
+    for (int i = 0; i < 63; ++i) {
+        blocks.push_back(arena.allocate(100));
+        ASSERT_NE(blocks.back(), nullptr);
+    }
+    for (char *p : blocks) {
+        for (size_t i = 0; i < LockedArena::block_size(100); ++i) {
+            ASSERT_EQ(p[i], 0);
+        }
+        std::memset(p, 0x5A, 100);
+    }
+    EXPECT_EQ(arena.stats().regions, 1u);
+    for (char *p : blocks) {
+        std::memset(p, 0, LockedArena::block_size(100));
+        arena.release(p, 100);
+    }
+}
+
+// Test: Storage::Secret uses memfd_secret where available, otherwise the
+// locked arena or the heap
+TEST(LockedArenaTest, SecretSecureBufferStorage) {
+    SecureBuffer key(48, SecureBuffer::Storage::Secret);
+    EXPECT_EQ(key.size_bytes(), 48u);
+    if (LockedArena::secret_supported() && LockedArena::secret_instance().stats().regions > 0) {
+        EXPECT_EQ(key.storage(), SecureBuffer::Storage::Secret);
+    } else {
+        EXPECT_NE(key.storage(), SecureBuffer::Storage::Secret);
+    }
+    std::memcpy(key.data_ptr(), "0123456789abcdef0123456789abcdef0123456789abcdef", 48);
+    key.append("tail", 4);
+    EXPECT_EQ(std::memcmp(key.data_ptr(), "0123456789", 10), 0);
+    EXPECT_EQ(std::memcmp(key.data_ptr() + 48, "tail", 4), 0);
+
+    SecureBuffer large(LockedArena::MaxBlock + 1, SecureBuffer::Storage::Secret);
+    EXPECT_EQ(large.storage(), SecureBuffer::Storage::Heap);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "include/NonTemporal.hpp"
+#include "include/SecureBuffer.hpp"
+#include "include/SecureWipe.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// Test: streaming zero and copy touch exactly [offset, offset + len)
+TEST(NonTemporalTest, ZeroAndCopyExactRange) {
+    const size_t lengths[] = {1, 63, 64, 65, 127, 128, 129, 4096 + 7};
+    for (size_t len : lengths) {
+        for (size_t offset : {0, 1, 31, 63}) {
+            std::vector<unsigned char> mem(len + 192, 0xAB), src(len + 192);
+            for (size_t i = 0; i < src.size(); ++i) {
+                src[i] = static_cast<unsigned char>(i * 13 + 1);
+            }
+            nontemporal::zero(mem.data() + offset, len);
+            for (size_t i = 0; i < mem.size(); ++i) {
+                const bool inside = i >= offset && i < offset + len;
+                ASSERT_EQ(mem[i], inside ? 0x00 : 0xAB) << "len=" << len << " offset=" << offset;
+            }
+            nontemporal::copy(mem.data() + offset, src.data() + 5, len);
+            for (size_t i = 0; i < mem.size(); ++i) {
+                const bool inside = i >= offset && i < offset + len;
+                ASSERT_EQ(mem[i], inside ? src[i - offset + 5] : 0xAB) << "len=" << len << " offset=" << offset;
+            }
+        }
+    }
+}
+
+// Test: the threshold is derived from the cache and can be overridden
+TEST(NonTemporalTest, Threshold) {
+    EXPECT_GT(nontemporal::threshold(), 0u);
+    const size_t derived = nontemporal::threshold();
+    nontemporal::set_threshold(4096);
+    EXPECT_EQ(nontemporal::threshold(), 4096u);
+    nontemporal::set_threshold(0);
+    EXPECT_EQ(nontemporal::threshold(), derived);
+}
+
+// Test: write() copies in place on both paths and rejects out-of-range writes
+TEST(NonTemporalTest, SecureBufferWrite) {
+    std::vector<char> src(100000);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<char>(i % 251 + 1);
+    }
+    // 0 restores the cache-derived default (regular stores at this size).
+    for (size_t threshold : {size_t(0), size_t(1024)}) {
+        nontemporal::set_threshold(threshold);
+        SecureBuffer buf(src.size() + 10);
+        buf.write(3, src.data(), src.size());
+        EXPECT_EQ(buf.data_ptr()[0], 0);
+        EXPECT_EQ(std::memcmp(buf.data_ptr() + 3, src.data(), src.size()), 0);
+        EXPECT_EQ(buf.data_ptr()[src.size() + 3], 0);
+
+        // With the low threshold the wipe streams as well.
+        securewipe::wipe(buf.data_ptr(), buf.size_bytes());
+        for (size_t i = 0; i < buf.size_bytes(); ++i) {
+            ASSERT_EQ(buf.data_ptr()[i], 0);
+        }
+        EXPECT_THROW(buf.write(buf.size_bytes() - 1, src.data(), 2), std::out_of_range);
+        EXPECT_THROW(buf.write(buf.size_bytes() + 1, src.data(), 0), std::out_of_range);
+    }
+    nontemporal::set_threshold(0);
+}
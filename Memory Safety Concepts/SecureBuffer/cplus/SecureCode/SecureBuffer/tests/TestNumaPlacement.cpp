@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "include/NumaPlacement.hpp"
+#include "include/PageAllocator.hpp"
+#include "include/SecureBuffer.hpp"
+#include "include/SecurePool.hpp"
+#include <cstring>
+
+// Test: the topology queries return sane values on any machine
+TEST(NumaPlacementTest, Topology) {
+    EXPECT_GE(numa::node_count(), 1);
+    EXPECT_GE(numa::current_node(), 0);
+    EXPECT_LT(numa::current_node(), numa::node_count());
+}
+
+// Test: mappings placed on a node are zeroed and land on that node
+TEST(NumaPlacementTest, MapOnNode) {
+    const int node = numa::node_count() - 1;
+    const size_t len = 4 * pagealloc::page_size();
+    char *p = numa::map_on_node(len, node);
+    for (size_t i = 0; i < len; ++i) {
+        ASSERT_EQ(p[i], 0);
+    }
+    std::memset(p, 0x11, len);
+    const int actual = numa::node_of(p);
+    if (actual >= 0) {
+        EXPECT_EQ(actual, node);
+    }
+    pagealloc::unmap(p, len);
+}
+
+// Test: Storage::Numa uses the node's pool for small sizes and keeps the
+// node across growth
+TEST(NumaPlacementTest, SecureBufferOnNode) {
+    const int node = numa::node_count() - 1;
+    SecureBuffer small(100, SecureBuffer::Storage::Numa, node);
+    EXPECT_EQ(small.storage(), SecureBuffer::Storage::Numa);
+    EXPECT_EQ(small.numa_node(), node);
+    EXPECT_EQ(small.capacity(), SecurePool::block_size(100));
+
+    const SecurePool::Stats before = SecurePool::for_node(node).stats();
+    small.append("secret", 6);
+    small.resize(20000);
+    EXPECT_EQ(small.storage(), SecureBuffer::Storage::Numa);
+    EXPECT_EQ(small.numa_node(), node);
+    EXPECT_EQ(std::memcmp(small.data_ptr() + 100, "secret", 6), 0);
+    EXPECT_EQ(SecurePool::for_node(node).stats().releases, before.releases + 1);
+
+    SecureBuffer here(64, SecureBuffer::Storage::Numa);
+    EXPECT_EQ(here.numa_node(), numa::current_node());
+    EXPECT_EQ(SecureBuffer(10, SecureBuffer::Storage::Heap).numa_node(), -1);
+}
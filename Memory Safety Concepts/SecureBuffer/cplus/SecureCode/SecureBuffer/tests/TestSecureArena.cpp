@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "include/SecureArena.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Test: allocations are zeroed, aligned and packed into one chunk
+TEST(SecureArenaTest, BumpAllocatesZeroedAlignedBytes) {
+    SecureArena arena;
+    for (int i = 0; i < 100; ++i) {
+        SecureSpan s = arena.allocate(24);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(s.data()) % alignof(std::max_align_t), 0u);
+        for (std::byte b : s) {
+            EXPECT_EQ(b, std::byte{0});
+        }
+        std::memset(s.data(), 0x61, s.size());
+    }
+    EXPECT_EQ(arena.chunk_count(), 1u);
+
+    SecureSpan page = arena.allocate(100, 4096);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(page.data()) % 4096, 0u);
+}
+
+// Test: reset wipes every byte handed out and keeps the first chunk
+TEST(SecureArenaTest, ResetWipesUsedRegion) {
+    SecureArena arena(1024);
+    std::vector<unsigned char *> first_chunk;
+    for (int i = 0; i < 10; ++i) {
+        SecureSpan s = arena.allocate(64);
+        std::memset(s.data(), 0x62, s.size());
+        first_chunk.push_back(reinterpret_cast<unsigned char *>(s.data()));
+    }
+    arena.allocate(5000); // oversized: gets its own chunk
+    EXPECT_EQ(arena.chunk_count(), 2u);
+
+    arena.reset();
+    EXPECT_EQ(arena.chunk_count(), 1u);
+    EXPECT_EQ(arena.bytes_used(), 0u);
+    for (unsigned char *p : first_chunk) {
+        for (int j = 0; j < 64; ++j) {
+            ASSERT_EQ(p[j], 0);
+        }
+    }
+    SecureSpan again = arena.allocate(64);
+    EXPECT_EQ(reinterpret_cast<unsigned char *>(again.data()), first_chunk[0]);
+}
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include "include/SecureBuffer.hpp"
+#include <cstdint>
 #include <cstring> // for std::memcpy
+#include <cstdio>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <vector>
 
 // Test: constructor initializes buffer with zeros
 TEST(SecureBufferTest, InitializesWithZeros) {
@@ -45,4 +52,231 @@ TEST(SecureBufferTest, MoveAssignment) {
     EXPECT_EQ(buf2.size_bytes(), 16);
     EXPECT_STREQ(buf2.data_ptr(), "AssignTest");
     EXPECT_EQ(buf1.size_bytes(), 0);
-}
\ No newline at end of file
+}
+
+// Test: empty mapped buffers map nothing and can still grow
+TEST(SecureBufferTest, EmptyMappedBuffers) {
+    for (SecureBuffer::Storage storage : {SecureBuffer::Storage::Mapped, SecureBuffer::Storage::Numa}) {
+        SecureBuffer empty(0, storage);
+        EXPECT_EQ(empty.storage(), storage);
+        EXPECT_EQ(empty.size_bytes(), 0u);
+        EXPECT_EQ(empty.capacity(), 0u);
+        empty.append("grown", 5);
+        EXPECT_EQ(std::memcmp(empty.data_ptr(), "grown", 5), 0);
+    }
+}
+
+// Test: large buffers default to kernel-zeroed mappings, small ones to the heap
+TEST(SecureBufferTest, LargeBuffersUseZeroPages) {
+    SecureBuffer small(SecureBuffer::MappedThreshold - 1);
+    SecureBuffer large(SecureBuffer::MappedThreshold);
+    EXPECT_EQ(small.storage(), SecureBuffer::Storage::Heap);
+    EXPECT_EQ(large.storage(), SecureBuffer::Storage::Mapped);
+
+    for (size_t i = 0; i < large.size_bytes(); ++i) {
+        ASSERT_EQ(large.data_ptr()[i], 0);
+    }
+    large.data_ptr()[large.size_bytes() - 1] = 'x';
+    EXPECT_EQ(large.data_ptr()[large.size_bytes() - 1], 'x');
+}
+
+// Test: huge-page buffers report their backing and fall back to base pages
+TEST(SecureBufferTest, HugePageBacking) {
+    SecureBuffer big(3 * pagealloc::HugePageSize, SecureBuffer::Storage::Huge);
+    if (big.storage() == SecureBuffer::Storage::Huge) {
+        EXPECT_NE(big.page_backing(), pagealloc::Backing::Pages);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(big.data_ptr()) % pagealloc::HugePageSize, 0u);
+        EXPECT_EQ(big.capacity() % pagealloc::HugePageSize, 0u);
+    } else {
+        EXPECT_EQ(big.storage(), SecureBuffer::Storage::Mapped);
+        EXPECT_EQ(big.page_backing(), pagealloc::Backing::Pages);
+    }
+    for (size_t i = 0; i < big.size_bytes(); i += 4096) {
+        ASSERT_EQ(big.data_ptr()[i], 0);
+    }
+    big.data_ptr()[big.size_bytes() - 1] = 'x';
+    big.resize(4 * pagealloc::HugePageSize);
+    EXPECT_EQ(big.data_ptr()[3 * pagealloc::HugePageSize - 1], 'x');
+
+    // Too small to be worth a huge page: plain mapping.
+    SecureBuffer small(SecureBuffer::MappedThreshold, SecureBuffer::Storage::Huge);
+    EXPECT_EQ(small.storage(), SecureBuffer::Storage::Mapped);
+    EXPECT_EQ(small.page_backing(), pagealloc::Backing::Pages);
+    EXPECT_STREQ(pagealloc::backing_name(small.page_backing()), "pages");
+}
+
+// Test: large mapped wipes drop the pages and hand-wipe only the edges
+TEST(SecureBufferTest, DiscardWipeReturnsZeroPages) {
+    const size_t page = pagealloc::page_size();
+    const size_t bytes = 8 * SecureBuffer::DiscardThreshold;
+    SecureBuffer big(bytes, SecureBuffer::Storage::Mapped);
+    std::memset(big.data_ptr(), 0x5A, bytes);
+
+    // Shrink to a size that ends mid-page: the tail of that page is wiped by
+    // hand, everything after it is discarded.
+    const size_t keep = 3 * page + 123;
+    big.resize(keep);
+    unsigned char *base = reinterpret_cast<unsigned char *>(big.data_ptr());
+    std::vector<unsigned char> resident((bytes + page - 1) / page);
+    ASSERT_EQ(mincore(base, bytes, resident.data()), 0);
+    for (size_t p = 4; p < resident.size(); ++p) {
+        ASSERT_EQ(resident[p] & 1, 0) << "page " << p << " still resident";
+    }
+
+    big.resize(bytes);
+    for (size_t i = 0; i < keep; ++i) {
+        ASSERT_EQ(base[i], 0x5A);
+    }
+    for (size_t i = keep; i < bytes; ++i) {
+        ASSERT_EQ(base[i], 0) << "byte " << i;
+    }
+
+    // Same for a whole-buffer wipe.
+    std::memset(big.data_ptr(), 0x5A, bytes);
+    big.parallel_wipe();
+    big.resize(bytes);
+    for (size_t i = 0; i < bytes; ++i) {
+        ASSERT_EQ(base[i], 0) << "byte " << i;
+    }
+}
+
+// Test: an inline buffer grown in place after a move shows only zeros past
+// the moved bytes, whatever the destination held before
+TEST(SecureBufferTest, InlineMoveThenGrowIsZero) {
+    SecureBuffer src(16);
+    std::memset(src.data_ptr(), 'k', 16);
+    alignas(SecureBuffer) unsigned char raw[sizeof(SecureBuffer)];
+    std::memset(raw, 0xAB, sizeof(raw));
+    SecureBuffer *moved = new (raw) SecureBuffer(std::move(src));
+    moved->resize(SecureBuffer::InlineCapacity);
+    EXPECT_EQ(moved->storage(), SecureBuffer::Storage::Inline);
+    for (size_t i = 16; i < moved->size_bytes(); ++i) {
+        ASSERT_EQ(moved->data_ptr()[i], 0) << "byte " << i;
+    }
+    moved->~SecureBuffer();
+
+    SecureBuffer dst(SecureBuffer::InlineCapacity);
+    std::memset(dst.data_ptr(), 'd', dst.size_bytes());
+    SecureBuffer small(8);
+    std::memset(small.data_ptr(), 's', 8);
+    dst = std::move(small);
+    dst.resize(SecureBuffer::InlineCapacity);
+    EXPECT_EQ(dst.data_ptr()[7], 's');
+    for (size_t i = 8; i < dst.size_bytes(); ++i) {
+        ASSERT_EQ(dst.data_ptr()[i], 0) << "byte " << i;
+    }
+
+    SecureBuffer heap(SecureBuffer::MappedThreshold - 1);
+    std::memset(heap.data_ptr(), 'h', heap.size_bytes());
+    SecureBuffer key(8);
+    heap = std::move(key);
+    heap.resize(SecureBuffer::InlineCapacity);
+    for (size_t i = 0; i < heap.size_bytes(); ++i) {
+        ASSERT_EQ(heap.data_ptr()[i], 0) << "byte " << i;
+    }
+}
+
+// Test: small buffers are stored inside the object
+TEST(SecureBufferTest, SmallBuffersAreInline) {
+    SecureBuffer key(32);
+    EXPECT_EQ(key.storage(), SecureBuffer::Storage::Inline);
+    const char *obj = reinterpret_cast<const char *>(&key);
+    EXPECT_GE(key.data_ptr(), obj);
+    EXPECT_LT(key.data_ptr(), obj + sizeof(SecureBuffer));
+
+    SecureBuffer medium(SecureBuffer::InlineCapacity + 1);
+    EXPECT_EQ(medium.storage(), SecureBuffer::Storage::Heap);
+}
+
+// Test: moving an inline buffer copies the bytes and wipes the source
+TEST(SecureBufferTest, InlineMoveWipesSource) {
+    SecureBuffer buf1(16);
+    std::memcpy(buf1.data_ptr(), "InlineSecret", 13);
+    const char *old_bytes = buf1.data_ptr();
+
+    SecureBuffer buf2 = std::move(buf1);
+    EXPECT_STREQ(buf2.data_ptr(), "InlineSecret");
+    EXPECT_EQ(buf1.size_bytes(), 0u);
+    for (size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(old_bytes[i], 0);
+    }
+
+    SecureBuffer buf3(1024);
+    buf3 = std::move(buf2);
+    EXPECT_EQ(buf3.storage(), SecureBuffer::Storage::Inline);
+    EXPECT_STREQ(buf3.data_ptr(), "InlineSecret");
+    EXPECT_EQ(buf2.size_bytes(), 0u);
+}
+
+// Test: append grows geometrically and keeps the existing contents
+TEST(SecureBufferTest, AppendGrowsGeometrically) {
+    SecureBuffer buf(0);
+    std::string expected;
+    size_t reallocations = 0;
+    size_t last_cap = buf.capacity();
+    for (int i = 0; i < 10000; ++i) {
+        char rec[8];
+        std::snprintf(rec, sizeof(rec), "%07d", i);
+        buf.append(rec, 7);
+        expected.append(rec, 7);
+        if (buf.capacity() != last_cap) {
+            ++reallocations;
+            last_cap = buf.capacity();
+        }
+    }
+    EXPECT_EQ(buf.size_bytes(), expected.size());
+    EXPECT_EQ(std::memcmp(buf.data_ptr(), expected.data(), expected.size()), 0);
+    EXPECT_LT(reallocations, 20u);
+}
+
+// Test: sizes whose arithmetic would overflow throw instead of wrapping into
+// a smaller allocation, and leave the buffer unchanged
+TEST(SecureBufferTest, GrowthRejectsOverflow) {
+    SecureBuffer buf(100);
+    std::memset(buf.data_ptr(), 'o', 100);
+    const char byte = 'x';
+    EXPECT_THROW(buf.append(&byte, SIZE_MAX), std::length_error);
+    EXPECT_THROW(buf.append(&byte, SIZE_MAX - 50), std::length_error);
+    EXPECT_THROW(buf.append(&byte, SecureBuffer::max_size() - 99), std::length_error);
+    EXPECT_THROW(buf.resize(SIZE_MAX), std::length_error);
+    EXPECT_THROW(buf.reserve(SecureBuffer::max_size() + 1), std::length_error);
+    EXPECT_EQ(buf.size_bytes(), 100u);
+    EXPECT_EQ(buf.data_ptr()[99], 'o');
+    buf.append(&byte, 1);
+    EXPECT_EQ(buf.data_ptr()[100], 'x');
+}
+
+// Test: resize exposes zeros when growing and wipes the tail when shrinking
+TEST(SecureBufferTest, ResizeZeroesAndWipes) {
+    SecureBuffer buf(100);
+    std::memset(buf.data_ptr(), 'x', 100);
+
+    buf.resize(10);
+    EXPECT_EQ(buf.size_bytes(), 10u);
+    EXPECT_EQ(buf.data_ptr()[10], 0);
+    EXPECT_EQ(buf.data_ptr()[99], 0);
+
+    buf.resize(5000);
+    EXPECT_EQ(buf.size_bytes(), 5000u);
+    EXPECT_EQ(buf.data_ptr()[9], 'x');
+    for (size_t i = 10; i < buf.size_bytes(); ++i) {
+        ASSERT_EQ(buf.data_ptr()[i], 0);
+    }
+}
+
+// Test: reserve changes capacity only and keeps the storage source
+TEST(SecureBufferTest, ReserveKeepsStorage) {
+    SecureBuffer buf(40, SecureBuffer::Storage::Pool);
+    std::memcpy(buf.data_ptr(), "pooled", 7);
+    buf.reserve(1000);
+    EXPECT_GE(buf.capacity(), 1000u);
+    EXPECT_EQ(buf.size_bytes(), 40u);
+    EXPECT_EQ(buf.storage(), SecureBuffer::Storage::Pool);
+    EXPECT_STREQ(buf.data_ptr(), "pooled");
+
+    SecureBuffer small(16);
+    std::memcpy(small.data_ptr(), "inline", 7);
+    small.reserve(SecureBuffer::InlineCapacity + 1);
+    EXPECT_EQ(small.storage(), SecureBuffer::Storage::Heap);
+    EXPECT_STREQ(small.data_ptr(), "inline");
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "include/SecureIO.hpp"
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Test: a read assembles input that arrives one byte per write
+TEST(SecureIOTest, ReadResumesPartialReads) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const std::string secret = "0123456789abcdefghijklmnopqrstuv";
+    std::thread writer([&] {
+        for (char c : secret) {
+            ASSERT_EQ(write(fds[1], &c, 1), 1);
+            std::this_thread::yield();
+        }
+        close(fds[1]);
+    });
+    SecureBuffer key(secret.size());
+    EXPECT_EQ(key.read_from(fds[0]), secret.size());
+    writer.join();
+    EXPECT_EQ(std::memcmp(key.data_ptr(), secret.data(), secret.size()), 0);
+
+    // The writer is gone: end of file gives a short (here empty) read.
+    EXPECT_EQ(key.read_from(fds[0]), 0u);
+    close(fds[0]);
+}
+
+// Test: one call fills several buffers and stops short at end of file
+TEST(SecureIOTest, ScatterReadAcrossBuffers) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "aaaabbbbbbbbcc", 14), 14);
+    close(fds[1]);
+
+    std::vector<SecureBuffer> keys;
+    keys.emplace_back(4);
+    keys.emplace_back(8);
+    keys.emplace_back(0);
+    keys.emplace_back(4);
+    EXPECT_EQ(secureio::read_from(fds[0], keys), 14u);
+    EXPECT_EQ(std::memcmp(keys[0].data_ptr(), "aaaa", 4), 0);
+    EXPECT_EQ(std::memcmp(keys[1].data_ptr(), "bbbbbbbb", 8), 0);
+    EXPECT_EQ(std::memcmp(keys[3].data_ptr(), "cc\0\0", 4), 0);
+    close(fds[0]);
+}
+
+// Test: writes larger than the pipe capacity complete across partial writes
+TEST(SecureIOTest, GatherWriteResumesPartialWrites) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::vector<SecureBuffer> bufs;
+    size_t total = 0;
+    for (int i = 0; i < 3; ++i) {
+        bufs.emplace_back(size_t(200) << 10);
+        std::memset(bufs.back().data_ptr(), 'a' + i, bufs.back().size_bytes());
+        total += bufs.back().size_bytes();
+    }
+    std::string received;
+    std::thread reader([&] {
+        char chunk[4096];
+        ssize_t n;
+        while ((n = read(fds[0], chunk, sizeof(chunk))) > 0) {
+            received.append(chunk, static_cast<size_t>(n));
+        }
+    });
+    EXPECT_EQ(secureio::write_to(fds[1], bufs), total);
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+    ASSERT_EQ(received.size(), total);
+    for (size_t i = 0; i < total; ++i) {
+        ASSERT_EQ(received[i], 'a' + static_cast<char>(i / (size_t(200) << 10)));
+    }
+}
+
+// Test: errors surface as std::system_error
+TEST(SecureIOTest, ErrorsThrow) {
+    SecureBuffer key(16);
+    EXPECT_THROW(key.read_from(-1), std::system_error);
+    EXPECT_THROW(key.write_to(-1), std::system_error);
+}
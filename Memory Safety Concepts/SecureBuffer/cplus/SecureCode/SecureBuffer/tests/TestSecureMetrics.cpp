@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "include/SecureBuffer.hpp"
+#include "include/SecureMetrics.hpp"
+#include "include/WipeThreadPool.hpp"
+#include <thread>
+#include <utility>
+
+// Test: lifecycle events are counted only while metrics are enabled
+TEST(SecureMetricsTest, CountsLifecycleEvents) {
+    const securemetrics::Snapshot before = securemetrics::snapshot();
+    securemetrics::enable();
+    {
+        SecureBuffer a(1000, SecureBuffer::Storage::Heap);
+        SecureBuffer b(std::move(a));
+        SecureBuffer c(16);
+        c = std::move(b);
+        EXPECT_EQ(securemetrics::snapshot().live_bytes() - before.live_bytes(), 1000u);
+    }
+    securemetrics::disable();
+    SecureBuffer ignored(1000, SecureBuffer::Storage::Heap);
+
+    const securemetrics::Snapshot after = securemetrics::snapshot();
+    EXPECT_EQ(after.constructions - before.constructions, 2u);
+    EXPECT_EQ(after.moves - before.moves, 2u);
+    EXPECT_EQ(after.bytes_allocated - before.bytes_allocated, 1000u);
+    EXPECT_EQ(after.bytes_released - before.bytes_released, 1000u);
+    EXPECT_EQ(after.bytes_wiped - before.bytes_wiped, 1016u);
+    EXPECT_EQ(after.wipes - before.wipes, 2u);
+
+    uint64_t histogram = 0;
+    for (size_t i = 0; i < securemetrics::HistogramBuckets; ++i) {
+        histogram += after.wipe_latency[i] - before.wipe_latency[i];
+    }
+    EXPECT_EQ(histogram, 2u);
+}
+
+// Test: wipes that discard pages count as one timed wipe of the whole range,
+// and untimed wipes are still counted
+TEST(SecureMetricsTest, CountsDiscardAndUntimedWipes) {
+    const securemetrics::Snapshot before = securemetrics::snapshot();
+    securemetrics::enable();
+    {
+        SecureBuffer big(2 * SecureBuffer::DiscardThreshold, SecureBuffer::Storage::Mapped);
+        big.data_ptr()[0] = 1;
+    }
+    securemetrics::enable(false);
+    {
+        SecureBuffer small(100, SecureBuffer::Storage::Heap);
+    }
+    securemetrics::disable();
+
+    const securemetrics::Snapshot after = securemetrics::snapshot();
+    EXPECT_EQ(after.wipes - before.wipes, 2u);
+    EXPECT_EQ(after.bytes_wiped - before.bytes_wiped, 2 * SecureBuffer::DiscardThreshold + 100);
+    uint64_t histogram = 0;
+    for (size_t i = 0; i < securemetrics::HistogramBuckets; ++i) {
+        histogram += after.wipe_latency[i] - before.wipe_latency[i];
+    }
+    EXPECT_EQ(histogram, 1u);
+}
+
+// Test: a parallel wipe counts as one timed wipe of the whole buffer
+TEST(SecureMetricsTest, CountsParallelWipes) {
+    WipeThreadPool pool(2);
+    const size_t len = WipeThreadPool::MinParallelBytes + 100;
+    SecureBuffer buf(len, SecureBuffer::Storage::Heap);
+    securemetrics::enable();
+    const securemetrics::Snapshot before = securemetrics::snapshot();
+    buf.parallel_wipe(pool);
+    const securemetrics::Snapshot after = securemetrics::snapshot();
+    securemetrics::disable();
+
+    EXPECT_EQ(after.wipes - before.wipes, 1u);
+    EXPECT_EQ(after.bytes_wiped - before.bytes_wiped, len);
+    uint64_t histogram = 0;
+    for (size_t i = 0; i < securemetrics::HistogramBuckets; ++i) {
+        histogram += after.wipe_latency[i] - before.wipe_latency[i];
+    }
+    EXPECT_EQ(histogram, 1u);
+}
+
+// Test: a latency of exactly 2^i ns falls in the bucket labelled le=2^i
+TEST(SecureMetricsTest, BucketBoundsAreInclusive) {
+    securemetrics::enable();
+    const securemetrics::Snapshot before = securemetrics::snapshot();
+    securemetrics::detail::record_wipe(8, 1);
+    securemetrics::detail::record_wipe(8, 32);
+    securemetrics::detail::record_wipe(8, 33);
+    const securemetrics::Snapshot after = securemetrics::snapshot();
+    securemetrics::disable();
+    EXPECT_EQ(after.wipe_latency[0] - before.wipe_latency[0], 1u);
+    EXPECT_EQ(after.wipe_latency[5] - before.wipe_latency[5], 1u);
+    EXPECT_EQ(after.wipe_latency[6] - before.wipe_latency[6], 1u);
+}
+
+// Test: counters of exited threads are still included in the totals
+TEST(SecureMetricsTest, AggregatesExitedThreads) {
+    const securemetrics::Snapshot before = securemetrics::snapshot();
+    securemetrics::enable();
+    std::thread([] {
+        for (int i = 0; i < 10; ++i) {
+            SecureBuffer buf(32);
+        }
+    }).join();
+    securemetrics::disable();
+    EXPECT_EQ(securemetrics::snapshot().constructions - before.constructions, 10u);
+}
+
+// Test: the exporter emits Prometheus counters and a cumulative histogram
+TEST(SecureMetricsTest, PrometheusExposition) {
+    securemetrics::Snapshot s;
+    s.constructions = 3;
+    s.bytes_allocated = 4096;
+    s.bytes_released = 1024;
+    s.wipes = 2;
+    s.wipe_latency[5] = 1;
+    s.wipe_latency[7] = 1;
+    const std::string text = securemetrics::to_prometheus(s, "sb");
+
+    EXPECT_NE(text.find("# TYPE sb_constructions_total counter\nsb_constructions_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("sb_live_bytes 3072\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE sb_wipes_total counter\nsb_wipes_total 2\n"), std::string::npos);
+    EXPECT_NE(text.find("sb_wipe_duration_seconds_bucket{le=\"3.2e-08\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("sb_wipe_duration_seconds_bucket{le=\"1.28e-07\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("sb_wipe_duration_seconds_bucket{le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("sb_wipe_duration_seconds_count 2\n"), std::string::npos);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "include/SecurePool.hpp"
+#include "include/SecureBuffer.hpp"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Test: requests are rounded up to power-of-two classes between 32 and 4096
+TEST(SecurePoolTest, SizeClasses) {
+    EXPECT_EQ(SecurePool::block_size(1), 32u);
+    EXPECT_EQ(SecurePool::block_size(32), 32u);
+    EXPECT_EQ(SecurePool::block_size(33), 64u);
+    EXPECT_EQ(SecurePool::block_size(4096), 4096u);
+    EXPECT_FALSE(SecurePool::fits(0));
+    EXPECT_FALSE(SecurePool::fits(4097));
+}
+
+// Test: a released block is handed out again and counted as a hit
+TEST(SecurePoolTest, ReusesReleasedBlocks) {
+    SecurePool pool;
+    char *a = pool.allocate(100);
+    EXPECT_EQ(pool.stats().misses, 1u);
+
+    std::memset(a, 0, 128);
+    pool.release(a, 100);
+    char *b = pool.allocate(128);
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(pool.stats().hits, 1u);
+    EXPECT_EQ(pool.stats().releases, 1u);
+    for (size_t i = 0; i < 128; ++i) {
+        EXPECT_EQ(b[i], 0);
+    }
+    pool.release(b, 128);
+}
+
+// Test: pooled SecureBuffers are zeroed, wiped on release and recycled
+TEST(SecurePoolTest, PooledSecureBufferRecycles) {
+    const char *first = nullptr;
+    {
+        SecureBuffer buf(48, SecureBuffer::Storage::Pool);
+        EXPECT_EQ(buf.storage(), SecureBuffer::Storage::Pool);
+        std::memcpy(buf.data_ptr(), "top-secret-key", 15);
+        first = buf.data_ptr();
+    }
+    SecurePool::Stats before = SecurePool::instance().stats();
+    SecureBuffer again(64, SecureBuffer::Storage::Pool);
+    SecurePool::Stats after = SecurePool::instance().stats();
+
+    EXPECT_EQ(again.data_ptr(), first);
+    EXPECT_EQ(after.hits, before.hits + 1);
+    for (size_t i = 0; i < again.size_bytes(); ++i) {
+        EXPECT_EQ(again.data_ptr()[i], 0);
+    }
+}
+
+// Test: sizes outside the pool classes fall back to the heap
+TEST(SecurePoolTest, OversizedFallsBackToHeap) {
+    SecureBuffer buf(8192, SecureBuffer::Storage::Pool);
+    EXPECT_EQ(buf.storage(), SecureBuffer::Storage::Heap);
+    EXPECT_EQ(buf.size_bytes(), 8192u);
+}
+
+// Test: buffers freed on another thread are recycled and exiting threads
+// hand their cached blocks back to the shared lists
+TEST(SecurePoolTest, CrossThreadReleaseAndThreadExit) {
+    std::vector<SecureBuffer> made;
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i) {
+            made.emplace_back(256, SecureBuffer::Storage::Pool);
+            std::memset(made.back().data_ptr(), 0x42, 256);
+        }
+    });
+    producer.join();
+
+    SecurePool::Stats before = SecurePool::instance().stats();
+    std::thread consumer([&] { made.clear(); });
+    consumer.join();
+    SecurePool::Stats after = SecurePool::instance().stats();
+    EXPECT_EQ(after.releases, before.releases + 1000);
+
+    // The consumer's magazine was flushed on exit, so another thread can
+    // allocate all of those blocks again without carving a new slab.
+    std::thread reuser([&] {
+        std::vector<SecureBuffer> again;
+        for (int i = 0; i < 1000; ++i) {
+            again.emplace_back(256, SecureBuffer::Storage::Pool);
+            for (size_t j = 0; j < 256; ++j) {
+                ASSERT_EQ(again.back().data_ptr()[j], 0);
+            }
+        }
+    });
+    reuser.join();
+    EXPECT_EQ(SecurePool::instance().stats().misses, after.misses);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "include/FixedSecureBuffer.hpp"
+#include "include/SecureBuffer.hpp"
+#include "include/SecureQueue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Test: FIFO order, bounded capacity and failed pushes keep the element
+TEST(SecureQueueTest, BoundedFifo) {
+    SecureQueue<SecureBuffer> q(3);
+    EXPECT_EQ(q.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        SecureBuffer b(8);
+        b.data_ptr()[0] = static_cast<char>('a' + i);
+        EXPECT_TRUE(q.try_push(std::move(b)));
+    }
+    SecureBuffer extra(8);
+    extra.data_ptr()[0] = 'z';
+    EXPECT_FALSE(q.try_push(std::move(extra)));
+    EXPECT_EQ(extra.size_bytes(), 8u);
+    EXPECT_EQ(extra.data_ptr()[0], 'z');
+
+    for (int i = 0; i < 4; ++i) {
+        std::optional<SecureBuffer> b = q.try_pop();
+        ASSERT_TRUE(b);
+        EXPECT_EQ(b->data_ptr()[0], 'a' + i);
+    }
+    EXPECT_FALSE(q.try_pop());
+}
+
+// Every SecureBytes holder must go through the queue the same way, whether
+// it owns its bytes by pointer (SecureBuffer) or inline (FixedSecureBuffer).
+template <typename T>
+class SecureQueueTypedTest : public ::testing::Test {
+protected:
+    static T make(char tag) {
+        T secret = [] {
+            if constexpr (std::is_same_v<T, SecureBuffer>)
+                return SecureBuffer(32);
+            else
+                return T();
+        }();
+        std::memset(secret.data_ptr(), tag, secret.size_bytes());
+        return secret;
+    }
+};
+
+using SecretTypes = ::testing::Types<SecureBuffer, Aes256Key>;
+TYPED_TEST_SUITE(SecureQueueTypedTest, SecretTypes);
+
+// Test: secrets come out in order with every byte intact, and elements
+// left queued are destroyed with the queue
+TYPED_TEST(SecureQueueTypedTest, MovesSecretsThrough) {
+    SecureQueue<TypeParam> q(4);
+    for (char tag = 'a'; tag < 'e'; ++tag) {
+        EXPECT_TRUE(q.try_push(this->make(tag)));
+    }
+    for (char tag = 'a'; tag < 'c'; ++tag) {
+        std::optional<TypeParam> s = q.try_pop();
+        ASSERT_TRUE(s);
+        ASSERT_EQ(s->size_bytes(), 32u);
+        for (size_t i = 0; i < s->size_bytes(); ++i) {
+            EXPECT_EQ(s->data_ptr()[i], tag);
+        }
+    }
+}
+
+// Element that leaves its bytes behind when moved from (like a plain key
+// struct) and remembers where it was last move-constructed, i.e. the cell.
+// The address is kept as an integer: temporaries are move-constructed too,
+// and a pointer to one of them would dangle.
+struct RecordingSecret {
+    static inline uintptr_t last_home = 0;
+    unsigned char bytes[32];
+
+    RecordingSecret() { std::memset(bytes, 0x7E, sizeof(bytes)); }
+    RecordingSecret(RecordingSecret &&o) noexcept {
+        std::memcpy(bytes, o.bytes, sizeof(bytes));
+        last_home = reinterpret_cast<uintptr_t>(bytes);
+    }
+};
+
+// Test: a vacated cell holds no trace of the secret, even for element types
+// that do not clean up after themselves
+TEST(SecureQueueTest, VacatedCellsAreWiped) {
+    SecureQueue<RecordingSecret> q(2);
+    ASSERT_TRUE(q.try_push(RecordingSecret()));
+    const unsigned char *cell = reinterpret_cast<const unsigned char *>(RecordingSecret::last_home);
+
+    auto out = q.try_pop();
+    ASSERT_TRUE(out);
+    EXPECT_EQ(out->bytes[31], 0x7E);
+    for (size_t i = 0; i < sizeof(RecordingSecret); ++i) {
+        EXPECT_EQ(cell[i], 0) << "byte " << i;
+    }
+}
+
+// Test: concurrent producers and consumers transfer every element exactly once
+TEST(SecureQueueTest, MultiProducerMultiConsumer) {
+    constexpr int Producers = 4, Consumers = 4, PerProducer = 5000;
+    SecureQueue<SecureBuffer> q(64);
+    std::atomic<long> sum{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < Producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < PerProducer; ++i) {
+                SecureBuffer b(sizeof(int));
+                int v = p * PerProducer + i;
+                std::memcpy(b.data_ptr(), &v, sizeof(v));
+                while (!q.try_push(std::move(b)))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < Consumers; ++c) {
+        threads.emplace_back([&] {
+            while (consumed.load() < Producers * PerProducer) {
+                if (auto b = q.try_pop()) {
+                    int v;
+                    std::memcpy(&v, b->data_ptr(), sizeof(v));
+                    sum += v;
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    const long n = Producers * PerProducer;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+}
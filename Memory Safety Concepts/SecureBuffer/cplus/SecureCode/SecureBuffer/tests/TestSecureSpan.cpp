@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "include/SecureBuffer.hpp"
+#include <cstring>
+
+// Test: a span aliases the buffer's storage without copying
+TEST(SecureSpanTest, ViewsBufferWithoutCopy) {
+    SecureBuffer buf(32);
+    std::memcpy(buf.data_ptr(), "header:payload", 14);
+
+    SecureSpan all = buf.span();
+    EXPECT_EQ(reinterpret_cast<char *>(all.data()), buf.data_ptr());
+    EXPECT_EQ(all.size(), 32u);
+
+    all[0] = std::byte{'H'};
+    EXPECT_EQ(buf.data_ptr()[0], 'H');
+}
+
+// Test: slicing is bounds checked and yields string views over the bytes
+TEST(SecureSpanTest, SubspanSlicing) {
+    SecureBuffer buf(14);
+    std::memcpy(buf.data_ptr(), "header:payload", 14);
+    const SecureBuffer &cbuf = buf;
+
+    SecureConstSpan all = cbuf.span();
+    EXPECT_EQ(all.first(6).as_string_view(), "header");
+    EXPECT_EQ(all.subspan(7).as_string_view(), "payload");
+    EXPECT_EQ(all.last(4).as_string_view(), "load");
+    EXPECT_TRUE(all.subspan(14).empty());
+
+    EXPECT_THROW(all.subspan(15), std::out_of_range);
+    EXPECT_THROW(all.subspan(10, 5), std::out_of_range);
+    EXPECT_THROW(all.first(15), std::out_of_range);
+    EXPECT_THROW(all.at(14), std::out_of_range);
+
+    SecureConstSpan converted = buf.span().subspan(7, 3);
+    EXPECT_EQ(converted.as_string_view(), "pay");
+}
+
+// Test: views are plain values that can be copied freely
+TEST(SecureSpanTest, TriviallyCopyable) {
+    static_assert(std::is_trivially_copyable_v<SecureSpan>);
+    SecureBuffer buf(8);
+    SecureSpan a = buf.span();
+    SecureSpan b;
+    std::memcpy(&b, &a, sizeof(a));
+    EXPECT_EQ(b.data(), a.data());
+    EXPECT_EQ(b.as_span().size(), 8u);
+}
+
+#ifdef SECUREBUFFER_DEBUG_VIEWS
+// Test: debug builds abort when a view outlives its buffer or storage
+TEST(SecureSpanDeathTest, StaleViewAborts) {
+    SecureSpan dangling;
+    {
+        SecureBuffer buf(16);
+        dangling = buf.span();
+    }
+    EXPECT_DEATH((void)dangling.data(), "outlived");
+
+    SecureBuffer grow(16);
+    SecureSpan before = grow.span();
+    grow.reserve(4096);
+    EXPECT_DEATH((void)before.data(), "outlived");
+}
+#endif
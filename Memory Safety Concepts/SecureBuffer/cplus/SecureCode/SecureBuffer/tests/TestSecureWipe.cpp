@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "include/SecureWipe.hpp"
+#include <vector>
+
+using securewipe::Kernel;
+
+static const Kernel kAllKernels[] = {Kernel::Scalar, Kernel::SSE2, Kernel::AVX2, Kernel::AVX512};
+
+// Test: every supported kernel zeroes exactly [offset, offset + len) for
+// lengths around the vector widths and for every alignment of the start
+TEST(SecureWipeTest, KernelsZeroExactRange) {
+    const size_t lengths[] = {1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 255, 256, 257, 4096 + 3};
+    for (Kernel k : kAllKernels) {
+        if (!securewipe::is_supported(k))
+            continue;
+        for (size_t len : lengths) {
+            for (size_t offset = 0; offset < 64; ++offset) {
+                std::vector<unsigned char> mem(len + 128, 0xAB);
+                securewipe::wipe_with(k, mem.data() + offset, len);
+                for (size_t i = 0; i < mem.size(); ++i) {
+                    bool inside = i >= offset && i < offset + len;
+                    ASSERT_EQ(mem[i], inside ? 0x00 : 0xAB)
+                        << securewipe::kernel_name(k) << " len=" << len
+                        << " offset=" << offset << " i=" << i;
+                }
+            }
+        }
+    }
+}
+
+// Test: dispatched wipe zeroes the buffer and tolerates null / empty input
+TEST(SecureWipeTest, DispatchedWipe) {
+    std::vector<unsigned char> mem(1000, 0xCD);
+    securewipe::wipe(mem.data(), mem.size());
+    for (unsigned char c : mem) {
+        EXPECT_EQ(c, 0);
+    }
+    securewipe::wipe(nullptr, 16);
+    securewipe::wipe(mem.data(), 0);
+}
+
+// Test: the scalar kernel is always available and the active one is supported
+TEST(SecureWipeTest, ActiveKernelIsSupported) {
+    EXPECT_TRUE(securewipe::is_supported(Kernel::Scalar));
+    EXPECT_TRUE(securewipe::is_supported(securewipe::active_kernel()));
+
+    // Stays the kernel bound on first use.
+    const Kernel k = securewipe::active_kernel();
+    char tmp[64] = {1};
+    securewipe::wipe(tmp, sizeof(tmp));
+    EXPECT_EQ(securewipe::active_kernel(), k);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "include/SecureBuffer.hpp"
+#include "include/SecureWipingResource.hpp"
+#include <cstring>
+#include <vector>
+
+// Upstream resource that records allocations and checks that every block it
+// gets back has been wiped
+class CheckingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t dirty_blocks = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        const char *c = static_cast<const char *>(p);
+        for (size_t i = 0; i < bytes; ++i) {
+            if (c[i] != 0) {
+                ++dirty_blocks;
+                break;
+            }
+        }
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &o) const noexcept override {
+        return this == &o;
+    }
+};
+
+// Test: SecureBuffer allocates from the resource and wipes before returning
+TEST(SecureWipingResourceTest, SecureBufferUsesResource) {
+    CheckingResource res;
+    {
+        SecureBuffer buf(100, &res);
+        EXPECT_EQ(buf.storage(), SecureBuffer::Storage::Resource);
+        EXPECT_EQ(res.allocations, 1u);
+        for (size_t i = 0; i < buf.size_bytes(); ++i) {
+            EXPECT_EQ(buf.data_ptr()[i], 0);
+        }
+        std::memset(buf.data_ptr(), 'k', buf.size_bytes());
+    }
+    EXPECT_EQ(res.deallocations, 1u);
+    EXPECT_EQ(res.dirty_blocks, 0u);
+}
+
+// Test: a monotonic arena over a wiping upstream releases every chunk wiped,
+// including bytes that were never owned by a SecureBuffer
+TEST(SecureWipingResourceTest, ArenaReleaseWipesChunks) {
+    CheckingResource res;
+    SecureWipingResource wiping(&res);
+    std::pmr::monotonic_buffer_resource arena(&wiping);
+
+    std::vector<SecureBuffer> buffers;
+    for (int i = 0; i < 200; ++i) {
+        buffers.emplace_back(48, &arena);
+        std::memset(buffers.back().data_ptr(), 't', 48);
+    }
+    char *raw = static_cast<char *>(arena.allocate(256));
+    std::memset(raw, 's', 256);
+
+    buffers.clear();
+    arena.release();
+
+    EXPECT_GT(res.deallocations, 0u);
+    EXPECT_EQ(res.deallocations, res.allocations);
+    EXPECT_EQ(res.dirty_blocks, 0u);
+}
+
+// Test: with BufferWipe::OnRelease, buffers in the arena skip their own wipe
+// and the arena release is the single pass that wipes them
+TEST(SecureWipingResourceTest, OnReleaseSkipsPerBufferWipe) {
+    CheckingResource res;
+    SecureWipingResource wiping(&res, SecureWipingResource::BufferWipe::OnRelease);
+    std::pmr::monotonic_buffer_resource arena(&wiping);
+    EXPECT_TRUE(SecureWipingResource::wipes_buffers(&arena));
+    EXPECT_TRUE(SecureWipingResource::wipes_buffers(&wiping));
+
+    std::vector<SecureBuffer> buffers;
+    std::vector<const char *> bytes;
+    for (int i = 0; i < 200; ++i) {
+        buffers.emplace_back(48, &arena);
+        std::memset(buffers.back().data_ptr(), 't', 48);
+        bytes.push_back(buffers.back().data_ptr());
+    }
+    buffers.clear();
+    // Still owned by the arena and not yet wiped: destruction did no work.
+    for (const char *p : bytes) {
+        ASSERT_EQ(p[0], 't');
+    }
+    arena.release();
+    EXPECT_EQ(res.deallocations, res.allocations);
+    EXPECT_EQ(res.dirty_blocks, 0u);
+}
+
+// Test: only wiping resources that opted in, and monotonic arenas directly on
+// them, let buffers skip their wipe
+TEST(SecureWipingResourceTest, DefaultResourcesKeepPerBufferWipe) {
+    SecureWipingResource wiping;
+    std::pmr::monotonic_buffer_resource arena(&wiping);
+    EXPECT_FALSE(SecureWipingResource::wipes_buffers(&wiping));
+    EXPECT_FALSE(SecureWipingResource::wipes_buffers(&arena));
+
+    SecureWipingResource on_release(std::pmr::new_delete_resource(), SecureWipingResource::BufferWipe::OnRelease);
+    std::pmr::unsynchronized_pool_resource pool(&on_release);
+    EXPECT_FALSE(SecureWipingResource::wipes_buffers(&pool));
+    EXPECT_FALSE(SecureWipingResource::wipes_buffers(std::pmr::new_delete_resource()));
+
+    CheckingResource res;
+    {
+        SecureBuffer buf(64, &res);
+        std::memset(buf.data_ptr(), 'k', 64);
+    }
+    EXPECT_EQ(res.dirty_blocks, 0u);
+}
+
+// Test: moving a resource-backed buffer keeps returning memory to that resource
+TEST(SecureWipingResourceTest, MovePreservesResource) {
+    CheckingResource res;
+    {
+        SecureBuffer a(256, &res);
+        SecureBuffer b(std::move(a));
+        SecureBuffer c(512);
+        c = std::move(b);
+        EXPECT_EQ(c.storage(), SecureBuffer::Storage::Resource);
+    }
+    EXPECT_EQ(res.deallocations, 1u);
+    EXPECT_EQ(res.dirty_blocks, 0u);
+}
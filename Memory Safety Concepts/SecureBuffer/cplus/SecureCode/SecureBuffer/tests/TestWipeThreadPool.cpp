@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "include/SecureBuffer.hpp"
+#include "include/WipeThreadPool.hpp"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Test: a parallel wipe zeroes exactly the requested (unaligned) range
+TEST(WipeThreadPoolTest, WipesExactRange) {
+    WipeThreadPool pool(3);
+    EXPECT_EQ(pool.thread_count(), 3u);
+    const size_t len = WipeThreadPool::MinParallelBytes * 3 + 12345;
+    std::vector<unsigned char> mem(len + 200, 0xAB);
+    pool.wipe(mem.data() + 77, len);
+    for (size_t i = 0; i < mem.size(); ++i) {
+        const bool inside = i >= 77 && i < 77 + len;
+        ASSERT_EQ(mem[i], inside ? 0x00 : 0xAB) << "i=" << i;
+    }
+}
+
+// Test: repeated and concurrent wipes on one pool all complete
+TEST(WipeThreadPoolTest, ConcurrentCallers) {
+    WipeThreadPool pool(2);
+    const size_t len = WipeThreadPool::MinParallelBytes * 2;
+    std::vector<std::vector<char>> bufs(4, std::vector<char>(len, 1));
+    std::vector<std::thread> callers;
+    for (auto &buf : bufs) {
+        callers.emplace_back([&pool, &buf] {
+            for (int round = 0; round < 5; ++round) {
+                std::memset(buf.data(), 1, buf.size());
+                pool.wipe(buf.data(), buf.size());
+            }
+        });
+    }
+    for (auto &t : callers) {
+        t.join();
+    }
+    for (auto &buf : bufs) {
+        for (size_t i = 0; i < buf.size(); i += 4093) {
+            ASSERT_EQ(buf[i], 0);
+        }
+    }
+}
+
+// Test: parallel_wipe empties the buffer and keeps its capacity
+TEST(WipeThreadPoolTest, SecureBufferParallelWipe) {
+    WipeThreadPool pool(2);
+    const size_t len = WipeThreadPool::MinParallelBytes + 100;
+    SecureBuffer buf(len);
+    std::memset(buf.data_ptr(), 0x5A, len);
+    const size_t cap = buf.capacity();
+    buf.parallel_wipe(pool);
+    EXPECT_EQ(buf.size_bytes(), 0u);
+    EXPECT_EQ(buf.capacity(), cap);
+    buf.resize(len);
+    for (size_t i = 0; i < len; ++i) {
+        ASSERT_EQ(buf.data_ptr()[i], 0);
+    }
+
+    SecureBuffer small(100);
+    std::memset(small.data_ptr(), 0x5A, 100);
+    small.parallel_wipe();
+    small.resize(100);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(small.data_ptr()[i], 0);
+    }
+}
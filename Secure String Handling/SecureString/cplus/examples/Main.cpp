@@ -3,6 +3,7 @@
 
 int main()
 {
-    SecureString str(10);
+    SecureString str("correct horse battery staple");
+    std::cout << "matches: " << str.constant_time_equal("correct horse battery staple") << '\n';
     return 0;
-}
\ No newline at end of file
+}
@@ -1,24 +1,40 @@
 #ifndef SECURESTRING_HPP
 #define SECURESTRING_HPP
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
 // RAII Secure String
 class SecureString
 {
 private:
+    std::vector<char> data;
+
     static void secure_wipe(void *ptr, size_t len) noexcept;
 
 public:
-explicit SecureString(size_t s);
+    explicit SecureString(const std::string &str);
 
-// Disable copying
-SecureString(const SecureString &) = delete;
-SecureString &operator=(const SecureString &) = delete;
+    // Disable copying
+    SecureString(const SecureString &) = delete;
+    SecureString &operator=(const SecureString &) = delete;
 
-// Enable moving
-SecureString(SecureString &&other) noexcept;
-SecureString &operator=(SecureString &&other) noexcept;
+    // Enable moving
+    SecureString(SecureString &&other) noexcept;
+    SecureString &operator=(SecureString &&other) noexcept;
 
-~SecureString();
+    ~SecureString();
 
+    const char *c_str() const noexcept;
+    size_t size() const noexcept;
+
+    // Constant-time comparison (SSE2/AVX2 when available), for tokens and
+    // passwords. Different lengths compare unequal; otherwise the running
+    // time depends only on the length, never on where the strings differ.
+    bool constant_time_equal(const SecureString &other) const noexcept;
+    bool constant_time_equal(std::string_view other) const noexcept;
 };
-#endif // SECURESTRING_HPP
\ No newline at end of file
+
+#endif // SECURESTRING_HPP
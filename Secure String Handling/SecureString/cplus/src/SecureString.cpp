@@ -1,65 +1,177 @@
 #include "include/SecureString.hpp"
-#include <iostream>
-#include <vector>
 #include <algorithm>
-#include <string>
+#include <atomic>
+#include <cstdint>
 #include <cstring> // for memset_s (if available)
 
-class SecureString 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SECURESTRING_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
 {
-private:
-    std::vector<char> data;
+    using EqualFn = bool (*)(const unsigned char *, const unsigned char *, size_t) noexcept;
 
-    // Securely wipe memory (portable fallback if memset_s is unavailable)
-    static void secure_wipe(void* ptr, size_t len) noexcept {
-#if defined(__STDC_LIB_EXT1__)
-        // C11 memset_s guaranteed not to be optimized away
-        memset_s(ptr, len, 0, len);
-#else
-        volatile char* p = reinterpret_cast<volatile char*>(ptr);
-        while (len--) {
-            *p++ = 0;
-        }
+    // Hides a value from the optimizer so a difference accumulator can never
+    // be turned back into an early-exit comparison.
+    template <typename T>
+    inline T opaque(T v) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __asm__("" : "+r"(v));
 #endif
+        return v;
     }
 
-public:
-    explicit SecureString(const std::string& str) 
+    // Turns an accumulated difference into a bool without branching on it.
+    inline bool is_zero(uint64_t diff) noexcept
     {
-        data.resize(str.size() + 1);
-        std::copy(str.begin(), str.end(), data.begin());
-        data[str.size()] = '\0';
+        diff = opaque(diff);
+        return static_cast<bool>(1 & ((diff - 1) >> 63) & ~(diff >> 63));
     }
 
-    // Disable copying
-    SecureString(const SecureString&) = delete;
-    SecureString& operator=(const SecureString&) = delete;
+    uint64_t diff_scalar(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        uint64_t diff = 0;
+        for (size_t i = 0; i < len; ++i) {
+            diff |= opaque<uint64_t>(a[i] ^ b[i]);
+        }
+        return diff;
+    }
 
-    // Enable moving
-    SecureString(SecureString&& other) noexcept : data(std::move(other.data)) 
+    bool equal_scalar(const unsigned char *a, const unsigned char *b, size_t len) noexcept
     {
-        other.secure_wipe(other.data.data(), other.data.size());
-        other.data.clear();
+        return is_zero(diff_scalar(a, b, len));
     }
 
-    SecureString& operator=(SecureString&& other) noexcept 
+#ifdef SECURESTRING_X86
+    // One bit per non-zero byte of `v`. Uses only SSE2 (no 64-bit lane
+    // extraction), so it also builds for 32-bit x86.
+    __attribute__((target("sse2"))) inline uint64_t nonzero_bytes(__m128i v) noexcept
     {
-        if (this != &other) {
-            // Wipe existing data first
-            secure_wipe(data.data(), data.size());
+        return static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) ^ 0xFFFF);
+    }
 
-            data = std::move(other.data);
-            other.secure_wipe(other.data.data(), other.data.size());
-            other.data.clear();
+    // XOR both inputs 16/32 bytes at a time and OR the result into an
+    // accumulator; the only branches depend on the length.
+    __attribute__((target("sse2"))) bool equal_sse2(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        __m128i acc = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            acc = _mm_or_si128(acc, _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+                                                  _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i))));
         }
-        return *this;
+        const uint64_t lanes = nonzero_bytes(acc);
+        return is_zero(lanes | diff_scalar(a + i, b + i, len - i));
     }
 
-    ~SecureString() 
+    __attribute__((target("avx2"))) bool equal_avx2(const unsigned char *a, const unsigned char *b, size_t len) noexcept
     {
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            acc = _mm256_or_si256(acc, _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+                                                        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i))));
+        }
+        const __m128i folded = _mm_or_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        const uint64_t lanes = nonzero_bytes(folded);
+        return is_zero(lanes | diff_scalar(a + i, b + i, len - i));
+    }
+#endif
+
+    bool equal_resolve(const unsigned char *a, const unsigned char *b, size_t len) noexcept;
+
+    // Starts at the resolver, which picks the widest kernel on first use.
+    std::atomic<EqualFn> equal_fn{equal_resolve};
+
+    bool equal_resolve(const unsigned char *a, const unsigned char *b, size_t len) noexcept
+    {
+        EqualFn fn = equal_scalar;
+#ifdef SECURESTRING_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            fn = equal_avx2;
+        else if (__builtin_cpu_supports("sse2"))
+            fn = equal_sse2;
+#endif
+        equal_fn.store(fn, std::memory_order_relaxed);
+        return fn(a, b, len);
+    }
+
+    bool constant_time_equal_bytes(const char *a, const char *b, size_t len) noexcept
+    {
+        return equal_fn.load(std::memory_order_relaxed)(reinterpret_cast<const unsigned char *>(a),
+                                                        reinterpret_cast<const unsigned char *>(b), len);
+    }
+}
+
+// Securely wipe memory (portable fallback if memset_s is unavailable)
+void SecureString::secure_wipe(void *ptr, size_t len) noexcept
+{
+#if defined(__STDC_LIB_EXT1__)
+    // C11 memset_s guaranteed not to be optimized away
+    memset_s(ptr, len, 0, len);
+#else
+    volatile char *p = reinterpret_cast<volatile char *>(ptr);
+    while (len--) {
+        *p++ = 0;
+    }
+#endif
+}
+
+SecureString::SecureString(const std::string &str)
+{
+    data.resize(str.size() + 1);
+    std::copy(str.begin(), str.end(), data.begin());
+    data[str.size()] = '\0';
+}
+
+SecureString::SecureString(SecureString &&other) noexcept : data(std::move(other.data))
+{
+    other.secure_wipe(other.data.data(), other.data.size());
+    other.data.clear();
+}
+
+SecureString &SecureString::operator=(SecureString &&other) noexcept
+{
+    if (this != &other) {
+        // Wipe existing data first
         secure_wipe(data.data(), data.size());
+
+        data = std::move(other.data);
+        other.secure_wipe(other.data.data(), other.data.size());
+        other.data.clear();
     }
+    return *this;
+}
+
+SecureString::~SecureString()
+{
+    secure_wipe(data.data(), data.size());
+}
+
+const char *SecureString::c_str() const noexcept
+{
+    return data.empty() ? "" : data.data();
+}
+
+size_t SecureString::size() const noexcept
+{
+    return data.size() ? data.size() - 1 : 0;
+}
 
-    const char* c_str() const noexcept { return data.data(); }
-    size_t size() const noexcept { return data.size() ? data.size() - 1 : 0; }
-};
+// Compares with another SecureString without leaking where they differ.
+// The length is not treated as secret, so a length mismatch returns early.
+bool SecureString::constant_time_equal(const SecureString &other) const noexcept
+{
+    return constant_time_equal(std::string_view(other.c_str(), other.size()));
+}
+
+bool SecureString::constant_time_equal(std::string_view other) const noexcept
+{
+    if (other.size() != size())
+        return false;
+    return constant_time_equal_bytes(c_str(), other.data(), other.size());
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "include/SecureString.hpp"
+#include <string>
+#include <utility>
+
+// Test: constructor copies the string and keeps it NUL-terminated
+TEST(SecureStringTest, StoresString) {
+    SecureString s("token");
+    EXPECT_EQ(s.size(), 5u);
+    EXPECT_STREQ(s.c_str(), "token");
+}
+
+// Test: moving transfers the contents and leaves the source empty
+TEST(SecureStringTest, MoveLeavesSourceEmpty) {
+    SecureString a("secret");
+    SecureString b(std::move(a));
+    EXPECT_STREQ(b.c_str(), "secret");
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_STREQ(a.c_str(), "");
+}
+
+// Test: constant-time comparison finds a difference at any position and
+// treats different lengths as unequal
+TEST(SecureStringTest, ConstantTimeEqual) {
+    const std::string token(100, 'k');
+    SecureString s(token);
+    EXPECT_TRUE(s.constant_time_equal(token));
+    EXPECT_TRUE(s.constant_time_equal(SecureString(token)));
+    for (size_t pos = 0; pos < token.size(); ++pos) {
+        std::string other = token;
+        other[pos] = 'K';
+        ASSERT_FALSE(s.constant_time_equal(other)) << "pos=" << pos;
+    }
+    EXPECT_FALSE(s.constant_time_equal(token.substr(1)));
+    EXPECT_TRUE(SecureString("").constant_time_equal(""));
+}